@@ -146,6 +146,31 @@ IN_PROC_BROWSER_TEST_F(BraveNavigatorHardwareConcurrencyFarblingBrowserTest,
   EXPECT_EQ(completely_fake_value, 7);
 }
 
+// Tests that the farbling level cached by the renderer for a document follows
+// shields changes without a reload
+IN_PROC_BROWSER_TEST_F(BraveNavigatorHardwareConcurrencyFarblingBrowserTest,
+                       FarblingLevelFollowsSettingsChange) {
+  AllowFingerprinting();
+  NavigateToURLUntilLoadStop(farbling_url());
+  int real_value = ExecScriptGetInt(kHardwareConcurrencyScript, contents());
+  ASSERT_GE(real_value, 2);
+  // The maximum level can't be told apart from the real value otherwise.
+  if (real_value == 2 || real_value == 7)
+    return;
+
+  // The new rules reach the renderer asynchronously, so wait for the value
+  // to change. If the cached level is never invalidated, this never unblocks
+  // and the test times out.
+  BlockFingerprinting();
+  while (ExecScriptGetInt(kHardwareConcurrencyScript, contents()) != 7) {
+  }
+
+  AllowFingerprinting();
+  while (ExecScriptGetInt(kHardwareConcurrencyScript, contents()) !=
+         real_value) {
+  }
+}
+
 IN_PROC_BROWSER_TEST_F(BraveNavigatorHardwareConcurrencyFarblingBrowserTest,
                        FarbleNavigatorHardwareConcurrencyWorkers) {
   GURL url = embedded_test_server()->GetURL(
@@ -23,6 +23,7 @@
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/extension_registry.h"
 #include "net/dns/mock_host_resolver.h"
 #include "ui/base/ui_base_switches.h"
 
@@ -364,6 +365,46 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, IsNotGreaselionExtension) {
   EXPECT_FALSE(greaselion_service->IsGreaselionExtension("INVALID"));
 }
 
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
+                       FeatureToggleOnlyInstallsAffectedExtensions) {
+  ASSERT_TRUE(InstallMockExtension());
+
+  GreaselionService* greaselion_service =
+      GreaselionServiceFactory::GetForBrowserContext(profile());
+  ASSERT_TRUE(greaselion_service);
+  extensions::ExtensionRegistry* registry =
+      extensions::ExtensionRegistry::Get(profile());
+
+  const auto extension_ids = greaselion_service->GetExtensionIdsForTesting();
+  ASSERT_GT(extension_ids.size(), 0UL);
+  base::flat_map<extensions::ExtensionId, const extensions::Extension*>
+      extensions;
+  for (const auto& id : extension_ids)
+    extensions[id] = registry->enabled_extensions().GetByID(id);
+
+  // None of the rules depend on GitHub tips, so no extension should be
+  // converted or installed again
+  greaselion_service->SetFeatureEnabled(greaselion::GITHUB_TIPS, true);
+  GreaselionServiceWaiter(greaselion_service).Wait();
+
+  EXPECT_EQ(extension_ids, greaselion_service->GetExtensionIdsForTesting());
+  for (const auto& extension : extensions) {
+    EXPECT_EQ(extension.second,
+              registry->enabled_extensions().GetByID(extension.first));
+  }
+
+  // Only the rule with the auto-contribution precondition starts matching
+  greaselion_service->SetFeatureEnabled(greaselion::AUTO_CONTRIBUTION, true);
+  GreaselionServiceWaiter(greaselion_service).Wait();
+
+  EXPECT_EQ(extension_ids.size() + 1,
+            greaselion_service->GetExtensionIdsForTesting().size());
+  for (const auto& extension : extensions) {
+    EXPECT_EQ(extension.second,
+              registry->enabled_extensions().GetByID(extension.first));
+  }
+}
+
 
 IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
                       ScriptInjectionWithBrowserVersionConditionLowWild) {
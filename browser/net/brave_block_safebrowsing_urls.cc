@@ -7,6 +7,8 @@
 
 #include <vector>
 
+#include "base/no_destructor.h"
+#include "brave/browser/net/url_pattern_host_index.h"
 #include "extensions/common/url_pattern.h"
 #include "net/base/net_errors.h"
 #include "url/gurl.h"
@@ -15,36 +17,55 @@ namespace brave {
 
 const char kDummyUrl[] = "https://no-thanks.invalid";
 
+namespace {
+
+// Ids of the rules in the safe browsing reporting index
+enum Rule {
+  kAllowedRule,
+  kReportingRule,
+};
+
+const URLPatternHostIndex& GetSafeBrowsingReportingIndex() {
+  static const base::NoDestructor<URLPatternHostIndex> index([] {
+    const std::vector<URLPattern> allowed_patterns({
+        URLPattern(
+            URLPattern::SCHEME_HTTPS,
+            "https://sb-ssl.google.com/safebrowsing/clientreport/download*"),
+        URLPattern(URLPattern::SCHEME_HTTPS,
+                   "https://safebrowsing.google.com/safebrowsing/clientreport/"
+                   "crx-list-info*"),
+    });
+    const std::vector<URLPattern> reporting_patterns({
+        URLPattern(URLPattern::SCHEME_HTTPS,
+                   "https://sb-ssl.google.com/safebrowsing/clientreport/*"),
+        URLPattern(
+            URLPattern::SCHEME_HTTPS,
+            "https://safebrowsing.google.com/safebrowsing/clientreport/*"),
+        URLPattern(URLPattern::SCHEME_HTTPS,
+                   "https://safebrowsing.google.com/safebrowsing/report*"),
+        URLPattern(URLPattern::SCHEME_HTTPS,
+                   "https://safebrowsing.google.com/safebrowsing/uploads/*"),
+    });
+
+    URLPatternHostIndex index;
+    for (const auto& pattern : allowed_patterns)
+      index.Add(kAllowedRule, pattern);
+    for (const auto& pattern : reporting_patterns)
+      index.Add(kReportingRule, pattern);
+    return index;
+  }());
+  return *index;
+}
+
 bool IsSafeBrowsingReportingURL(const GURL& gurl) {
-  static const std::vector<URLPattern> allowed_patterns({
-      URLPattern(
-          URLPattern::SCHEME_HTTPS,
-          "https://sb-ssl.google.com/safebrowsing/clientreport/download*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://safebrowsing.google.com/safebrowsing/clientreport/"
-                 "crx-list-info*"),
-  });
-  static const std::vector<URLPattern> reporting_patterns({
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://sb-ssl.google.com/safebrowsing/clientreport/*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://safebrowsing.google.com/safebrowsing/clientreport/*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://safebrowsing.google.com/safebrowsing/report*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://safebrowsing.google.com/safebrowsing/uploads/*"),
-  });
-
-  if (std::any_of(
-          allowed_patterns.begin(), allowed_patterns.end(),
-          [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); })) {
-    return false;
-  }
-  return std::any_of(
-      reporting_patterns.begin(), reporting_patterns.end(),
-      [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); });
+  const std::vector<int> matches =
+      GetSafeBrowsingReportingIndex().GetMatchingIds(gurl);
+  // Matches are sorted, so an allowed URL always comes first
+  return !matches.empty() && matches.front() == kReportingRule;
 }
 
+}  // namespace
+
 int OnBeforeURLRequest_BlockSafeBrowsingReportingURLs(const GURL& request_url,
                                                       GURL* new_url) {
   DCHECK(new_url);
@@ -5,14 +5,17 @@
 
 #include "brave/browser/net/brave_common_static_redirect_network_delegate_helper.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
+#include "brave/browser/net/url_pattern_host_index.h"
 #include "brave/common/network_constants.h"
 #include "brave/components/brave_component_updater/browser/features.h"
 #include "brave/components/brave_component_updater/browser/switches.h"
@@ -47,25 +50,48 @@ std::string GetUpdateURLHost() {
   return UPDATER_DEV_ENDPOINT;
 }
 
-// Update server checks happen from the profile context for admin policy
-// installed extensions. Update server checks happen from the system context for
-// normal update operations.
-bool IsUpdaterURL(const GURL& gurl) {
-  static std::vector<URLPattern> updater_patterns(
-      {URLPattern(URLPattern::SCHEME_HTTPS,
-                  std::string(component_updater::kUpdaterJSONDefaultUrl) + "*"),
-       URLPattern(
-           URLPattern::SCHEME_HTTP,
-           std::string(component_updater::kUpdaterJSONFallbackUrl) + "*"),
+// Ids of the rules in the common static redirect index
+enum Rule {
+  kUpdaterRule,
+  kChromeCastRule,
+  kClients4Rule,
+  kBugsChromiumRule,
+};
+
+const URLPatternHostIndex& GetCommonStaticRedirectIndex() {
+  static const base::NoDestructor<URLPatternHostIndex> index([] {
+    const int kHttpAndHttps =
+        URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+    // Update server checks happen from the profile context for admin policy
+    // installed extensions. Update server checks happen from the system
+    // context for normal update operations.
+    const std::vector<URLPattern> updater_patterns(
+        {URLPattern(
+             URLPattern::SCHEME_HTTPS,
+             std::string(component_updater::kUpdaterJSONDefaultUrl) + "*"),
+         URLPattern(
+             URLPattern::SCHEME_HTTP,
+             std::string(component_updater::kUpdaterJSONFallbackUrl) + "*"),
 #if BUILDFLAG(ENABLE_EXTENSIONS)
-       URLPattern(
-           URLPattern::SCHEME_HTTPS,
-           std::string(extension_urls::kChromeWebstoreUpdateURL) + "*")
+         URLPattern(
+             URLPattern::SCHEME_HTTPS,
+             std::string(extension_urls::kChromeWebstoreUpdateURL) + "*")
 #endif
-  });
-  return std::any_of(
-      updater_patterns.begin(), updater_patterns.end(),
-      [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); });
+    });
+
+    URLPatternHostIndex index;
+    for (const auto& pattern : updater_patterns)
+      index.Add(kUpdaterRule, pattern);
+    index.Add(kChromeCastRule, URLPattern(kHttpAndHttps, kChromeCastPrefix));
+    index.Add(kClients4Rule, URLPattern(kHttpAndHttps, kClients4Prefix),
+              /* match_host_only */ true);
+    index.Add(kBugsChromiumRule,
+              URLPattern(kHttpAndHttps,
+                         "*://bugs.chromium.org/p/chromium/issues/entry?*"));
+    return index;
+  }());
+  return *index;
 }
 
 bool RewriteBugReportingURL(const GURL& request_url, GURL* new_url) {
@@ -115,16 +141,17 @@ int OnBeforeURLRequest_CommonStaticRedirectWorkForGURL(
     GURL* new_url) {
   DCHECK(new_url);
 
+  const std::vector<int> matches =
+      GetCommonStaticRedirectIndex().GetMatchingIds(request_url);
+  if (matches.empty())
+    return net::OK;
+
+  const auto matched = [&matches](Rule rule) {
+    return std::binary_search(matches.begin(), matches.end(), rule);
+  };
+
   GURL::Replacements replacements;
-  static URLPattern chromecast_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kChromeCastPrefix);
-  static URLPattern clients4_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kClients4Prefix);
-  static URLPattern bugsChromium_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      "*://bugs.chromium.org/p/chromium/issues/entry?*");
-
-  if (IsUpdaterURL(request_url)) {
+  if (matched(kUpdaterRule)) {
     auto update_host = GetUpdateURLHost();
     if (!update_host.empty()) {
       replacements.SetQueryStr(request_url.query_piece());
@@ -133,21 +160,21 @@ int OnBeforeURLRequest_CommonStaticRedirectWorkForGURL(
     return net::OK;
   }
 
-  if (chromecast_pattern.MatchesURL(request_url)) {
+  if (matched(kChromeCastRule)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr(kBraveRedirectorProxy);
     *new_url = request_url.ReplaceComponents(replacements);
     return net::OK;
   }
 
-  if (clients4_pattern.MatchesHost(request_url)) {
+  if (matched(kClients4Rule)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr(kBraveClients4Proxy);
     *new_url = request_url.ReplaceComponents(replacements);
     return net::OK;
   }
 
-  if (bugsChromium_pattern.MatchesURL(request_url)) {
+  if (matched(kBugsChromiumRule)) {
     if (RewriteBugReportingURL(request_url, new_url))
       return net::OK;
   }
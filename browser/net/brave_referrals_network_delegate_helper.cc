@@ -6,11 +6,10 @@
 #include "brave/browser/net/brave_referrals_network_delegate_helper.h"
 
 #include "base/values.h"
-#include "brave/components/brave_referrals/browser/brave_referrals_service.h"
+#include "brave/components/brave_referrals/browser/referral_headers.h"
 #include "brave/common/network_constants.h"
 #include "chrome/browser/browser_process.h"
 #include "content/public/browser/browser_thread.h"
-#include "extensions/common/url_pattern.h"
 #include "net/url_request/url_request.h"
 
 namespace brave {
@@ -19,19 +18,18 @@ int OnBeforeStartTransaction_ReferralsWork(
     net::HttpRequestHeaders* headers,
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
-  if (!ctx->referral_headers_list)
+  if (!ctx->referral_headers)
     return net::OK;
   // If the domain for this request matches one of our target domains,
   // set the associated custom headers.
-  const base::DictionaryValue* request_headers_dict = nullptr;
-  if (!BraveReferralsService::GetMatchingReferralHeaders(
-          *ctx->referral_headers_list, &request_headers_dict, ctx->request_url))
+  const ReferralHeaders::Headers* request_headers =
+      ctx->referral_headers->GetMatchingHeaders(ctx->request_url);
+  if (!request_headers)
     return net::OK;
-  for (const auto& it : request_headers_dict->DictItems()) {
-    if (it.first == kBravePartnerHeader) {
-      headers->SetHeader(it.first, it.second.GetString());
-      ctx->set_headers.insert(it.first);
-    }
+  const auto iter = request_headers->find(kBravePartnerHeader);
+  if (iter != request_headers->end()) {
+    headers->SetHeader(iter->first, iter->second);
+    ctx->set_headers.insert(iter->first);
   }
   return net::OK;
 }
@@ -11,6 +11,7 @@
 #include "base/json/json_reader.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
+#include "brave/components/brave_referrals/browser/referral_headers.h"
 #include "net/base/net_errors.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "url/gurl.h"
@@ -59,12 +60,10 @@ TEST(BraveReferralsNetworkDelegateHelperTest, ReplaceHeadersForMatchingDomain) {
   ASSERT_TRUE(referral_headers.value);
   ASSERT_TRUE(referral_headers.value->is_list());
 
-  const base::ListValue* referral_headers_list = nullptr;
-  referral_headers.value->GetAsList(&referral_headers_list);
-
   net::HttpRequestHeaders headers;
   auto request_info = std::make_shared<brave::BraveRequestInfo>(url);
-  request_info->referral_headers_list = referral_headers_list;
+  request_info->referral_headers =
+      std::make_shared<brave::ReferralHeaders>(*referral_headers.value);
 
   int rc = brave::OnBeforeStartTransaction_ReferralsWork(
       &headers, brave::ResponseCallback(), request_info);
@@ -88,12 +87,10 @@ TEST(BraveReferralsNetworkDelegateHelperTest,
   ASSERT_TRUE(referral_headers.value);
   ASSERT_TRUE(referral_headers.value->is_list());
 
-  const base::ListValue* referral_headers_list = nullptr;
-  referral_headers.value->GetAsList(&referral_headers_list);
-
   net::HttpRequestHeaders headers;
   auto request_info = std::make_shared<brave::BraveRequestInfo>(GURL());
-  request_info->referral_headers_list = referral_headers_list;
+  request_info->referral_headers =
+      std::make_shared<brave::ReferralHeaders>(*referral_headers.value);
   int rc = brave::OnBeforeStartTransaction_ReferralsWork(
       &headers, brave::ResponseCallback(), request_info);
 
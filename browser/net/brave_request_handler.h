@@ -59,12 +59,14 @@ class BraveRequestHandler {
       before_start_transaction_callbacks_;
   std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
 
-  // TODO(iefremov): actually, we don't have to keep the list here, since
-  // it is global for the whole browser and could live a singletonce in the
+  // TODO(iefremov): actually, we don't have to keep the headers here, since
+  // they are global for the whole browser and could live a singletonce in the
   // rewards service. Eliminating this will also help to avoid using
   // PrefChangeRegistrar and corresponding |base::Unretained| usages, that are
   // illegal.
-  std::unique_ptr<base::ListValue> referral_headers_list_;
+  // Compiled once per change of |kReferralHeaders| and shared with every
+  // request, so in-flight requests keep the headers they started with.
+  std::shared_ptr<const brave::ReferralHeaders> referral_headers_;
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
   std::unique_ptr<PrefChangeRegistrar, content::BrowserThread::DeleteOnUIThread>
       pref_change_registrar_;
@@ -10,7 +10,9 @@
 #include <string>
 #include <vector>
 
+#include "base/no_destructor.h"
 #include "base/strings/string_piece_forward.h"
+#include "brave/browser/net/url_pattern_host_index.h"
 #include "brave/browser/translate/buildflags/buildflags.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/translate_network_constants.h"
@@ -25,6 +27,72 @@ namespace {
 
 bool g_safebrowsing_api_endpoint_for_testing_ = false;
 
+// Ids of the rules in the static redirect index, in order of precedence
+enum Rule {
+  kGeoLocationRule,
+  kSafeBrowsingRule,
+  kSafeBrowsingFileCheckRule,
+  kSafeBrowsingCrxListRule,
+  kCRXDownloadRule,
+  kAutofillRule,
+  kCRLSetRule1,
+  kCRLSetRule2,
+  kCRLSetRule3,
+  kCRLSetRule4,
+  kGvt1Rule,
+  kWidevineGvt1Rule,
+  kGoogleDlRule,
+  kWidevineGoogleDlRule,
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+  kTranslateRule,
+  kTranslateLanguageRule,
+#endif
+};
+
+const URLPatternHostIndex& GetStaticRedirectIndex() {
+  static const base::NoDestructor<URLPatternHostIndex> index([] {
+    const int kHttpAndHttps =
+        URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+    URLPatternHostIndex index;
+    index.Add(kGeoLocationRule,
+              URLPattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern));
+    index.Add(kSafeBrowsingRule,
+              URLPattern(URLPattern::SCHEME_HTTPS, kSafeBrowsingPrefix),
+              /* match_host_only */ true);
+    index.Add(
+        kSafeBrowsingFileCheckRule,
+        URLPattern(URLPattern::SCHEME_HTTPS, kSafeBrowsingFileCheckPrefix),
+        /* match_host_only */ true);
+    index.Add(kSafeBrowsingCrxListRule,
+              URLPattern(URLPattern::SCHEME_HTTPS, kSafeBrowsingCrxListPrefix),
+              /* match_host_only */ true);
+    index.Add(kCRXDownloadRule, URLPattern(kHttpAndHttps, kCRXDownloadPrefix));
+    index.Add(kAutofillRule,
+              URLPattern(URLPattern::SCHEME_HTTPS, kAutofillPrefix));
+    // To-Do (@jumde) - Update the naming for the rules below
+    // https://github.com/brave/brave-browser/issues/10314
+    index.Add(kCRLSetRule1, URLPattern(kHttpAndHttps, kCRLSetPrefix1));
+    index.Add(kCRLSetRule2, URLPattern(kHttpAndHttps, kCRLSetPrefix2));
+    index.Add(kCRLSetRule3, URLPattern(kHttpAndHttps, kCRLSetPrefix3));
+    index.Add(kCRLSetRule4, URLPattern(kHttpAndHttps, kCRLSetPrefix4));
+    index.Add(kGvt1Rule, URLPattern(kHttpAndHttps, "*://*.gvt1.com/*"));
+    index.Add(kWidevineGvt1Rule,
+              URLPattern(kHttpAndHttps, kWidevineGvt1Prefix));
+    index.Add(kGoogleDlRule, URLPattern(kHttpAndHttps, "*://dl.google.com/*"));
+    index.Add(kWidevineGoogleDlRule,
+              URLPattern(kHttpAndHttps, kWidevineGoogleDlPrefix));
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+    index.Add(kTranslateRule,
+              URLPattern(URLPattern::SCHEME_HTTPS, kTranslateElementJSPattern));
+    index.Add(kTranslateLanguageRule,
+              URLPattern(URLPattern::SCHEME_HTTPS, kTranslateLanguagePattern));
+#endif
+    return index;
+  }());
+  return *index;
+}
+
 base::StringPiece GetSafeBrowsingEndpoint() {
   if (g_safebrowsing_api_endpoint_for_testing_)
     return kSafeBrowsingTestingEndpoint;
@@ -52,127 +120,90 @@ int OnBeforeURLRequest_StaticRedirectWork(
 int OnBeforeURLRequest_StaticRedirectWorkForGURL(
     const GURL& request_url,
     GURL* new_url) {
-  GURL::Replacements replacements;
-  static URLPattern geo_pattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern);
-  static URLPattern safeBrowsing_pattern(URLPattern::SCHEME_HTTPS,
-                                         kSafeBrowsingPrefix);
-  static URLPattern safebrowsingfilecheck_pattern(URLPattern::SCHEME_HTTPS,
-                                                  kSafeBrowsingFileCheckPrefix);
-  static URLPattern safebrowsingcrxlist_pattern(URLPattern::SCHEME_HTTPS,
-                                                kSafeBrowsingCrxListPrefix);
-
-  // To-Do (@jumde) - Update the naming for the variables below
-  // https://github.com/brave/brave-browser/issues/10314
-  static URLPattern crlSet_pattern1(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix1);
-  static URLPattern crlSet_pattern2(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix2);
-  static URLPattern crlSet_pattern3(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix3);
-  static URLPattern crlSet_pattern4(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix4);
-  static URLPattern crxDownload_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRXDownloadPrefix);
-  static URLPattern autofill_pattern(
-      URLPattern::SCHEME_HTTPS, kAutofillPrefix);
-  static URLPattern gvt1_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, "*://*.gvt1.com/*");
-  static URLPattern googleDl_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      "*://dl.google.com/*");
-
-  static URLPattern widevine_gvt1_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      kWidevineGvt1Prefix);
-  static URLPattern widevine_google_dl_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      kWidevineGoogleDlPrefix);
+  const std::vector<int> matches =
+      GetStaticRedirectIndex().GetMatchingIds(request_url);
+  if (matches.empty())
+    return net::OK;
 
-#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  static URLPattern translate_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateElementJSPattern);
-  static URLPattern translate_language_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateLanguagePattern);
-#endif
-  if (geo_pattern.MatchesURL(request_url)) {
+  const auto matched = [&matches](Rule rule) {
+    return std::binary_search(matches.begin(), matches.end(), rule);
+  };
+
+  GURL::Replacements replacements;
+  if (matched(kGeoLocationRule)) {
     *new_url = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
     return net::OK;
   }
 
   auto safebrowsing_endpoint = GetSafeBrowsingEndpoint();
-  if (!safebrowsing_endpoint.empty() &&
-      safeBrowsing_pattern.MatchesHost(request_url)) {
+  if (!safebrowsing_endpoint.empty() && matched(kSafeBrowsingRule)) {
     replacements.SetHostStr(safebrowsing_endpoint);
     *new_url = request_url.ReplaceComponents(replacements);
     return net::OK;
   }
 
-  if (!safebrowsing_endpoint.empty() &&
-      safebrowsingfilecheck_pattern.MatchesHost(request_url)) {
+  if (!safebrowsing_endpoint.empty() && matched(kSafeBrowsingFileCheckRule)) {
     replacements.SetHostStr(kBraveSafeBrowsingSslProxy);
     *new_url = request_url.ReplaceComponents(replacements);
     return net::OK;
   }
 
-  if (!safebrowsing_endpoint.empty() &&
-      safebrowsingcrxlist_pattern.MatchesHost(request_url)) {
+  if (!safebrowsing_endpoint.empty() && matched(kSafeBrowsingCrxListRule)) {
     replacements.SetHostStr(kBraveSafeBrowsing2Proxy);
     *new_url = request_url.ReplaceComponents(replacements);
     return net::OK;
   }
 
-  if (crxDownload_pattern.MatchesURL(request_url)) {
+  if (matched(kCRXDownloadRule)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr("crxdownload.brave.com");
     *new_url = request_url.ReplaceComponents(replacements);
     return net::OK;
   }
 
-  if (autofill_pattern.MatchesURL(request_url)) {
+  if (matched(kAutofillRule)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr(kBraveStaticProxy);
     *new_url = request_url.ReplaceComponents(replacements);
     return net::OK;
   }
 
-  if (crlSet_pattern1.MatchesURL(request_url)) {
+  if (matched(kCRLSetRule1)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr("crlsets.brave.com");
     *new_url = request_url.ReplaceComponents(replacements);
     return net::OK;
   }
 
-  if (crlSet_pattern2.MatchesURL(request_url)) {
+  if (matched(kCRLSetRule2)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr("crlsets.brave.com");
     *new_url = request_url.ReplaceComponents(replacements);
     return net::OK;
   }
 
-  if (crlSet_pattern3.MatchesURL(request_url)) {
+  if (matched(kCRLSetRule3)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr("crlsets.brave.com");
     *new_url = request_url.ReplaceComponents(replacements);
     return net::OK;
   }
 
-  if (crlSet_pattern4.MatchesURL(request_url)) {
+  if (matched(kCRLSetRule4)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr("crlsets.brave.com");
     *new_url = request_url.ReplaceComponents(replacements);
     return net::OK;
   }
 
-  if (gvt1_pattern.MatchesURL(request_url) &&
-      !widevine_gvt1_pattern.MatchesURL(request_url)) {
+  if (matched(kGvt1Rule) && !matched(kWidevineGvt1Rule)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr(kBraveRedirectorProxy);
     *new_url = request_url.ReplaceComponents(replacements);
     return net::OK;
   }
 
-  if (googleDl_pattern.MatchesURL(request_url) &&
-      !widevine_google_dl_pattern.MatchesURL(request_url)) {
+  if (matched(kGoogleDlRule) && !matched(kWidevineGoogleDlRule)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr(kBraveRedirectorProxy);
     *new_url = request_url.ReplaceComponents(replacements);
@@ -180,7 +211,7 @@ int OnBeforeURLRequest_StaticRedirectWorkForGURL(
   }
 
 #if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  if (translate_pattern.MatchesURL(request_url)) {
+  if (matched(kTranslateRule)) {
     replacements.SetQueryStr(request_url.query_piece());
     replacements.SetPathStr(request_url.path_piece());
     *new_url =
@@ -188,7 +219,7 @@ int OnBeforeURLRequest_StaticRedirectWorkForGURL(
     return net::OK;
   }
 
-  if (translate_language_pattern.MatchesURL(request_url)) {
+  if (matched(kTranslateLanguageRule)) {
     *new_url = GURL(kBraveTranslateLanguageEndpoint);
     return net::OK;
   }
@@ -8,8 +8,9 @@
 #include <memory>
 #include <string>
 
-#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "base/memory/ptr_util.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "brave/components/brave_shields/browser/shields_decision_cache.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
 #include "brave/components/brave_webtorrent/browser/webtorrent_util.h"
 #include "brave/components/ipfs/buildflags/buildflags.h"
@@ -17,6 +18,8 @@
 #include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/isolation_info.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/resource_request_body.h"
 
 #if BUILDFLAG(IPFS_ENABLED)
 #include "brave/components/ipfs/ipfs_constants.h"
@@ -31,12 +34,49 @@ namespace brave {
 
 namespace {
 
-std::string GetUploadData(const network::ResourceRequest& request) {
-  std::string upload_data;
-  if (!request.request_body) {
+// User data key for the profile's brave_shields::ShieldsDecisionCache.
+const void* const kShieldsDecisionCacheKey = &kShieldsDecisionCacheKey;
+
+brave_shields::ShieldsDecisionCache* GetShieldsDecisionCache(
+    content::BrowserContext* browser_context) {
+  auto* cache = static_cast<brave_shields::ShieldsDecisionCache*>(
+      browser_context->GetUserData(kShieldsDecisionCacheKey));
+  if (!cache) {
+    cache = new brave_shields::ShieldsDecisionCache(
+        HostContentSettingsMapFactory::GetForProfile(
+            Profile::FromBrowserContext(browser_context)));
+    browser_context->SetUserData(kShieldsDecisionCacheKey,
+                                 base::WrapUnique(cache));
+  }
+  return cache;
+}
+
+}  // namespace
+
+BraveRequestInfo::BraveRequestInfo() = default;
+
+BraveRequestInfo::BraveRequestInfo(const GURL& url) : request_url(url) {}
+
+BraveRequestInfo::~BraveRequestInfo() = default;
+
+std::string BraveRequestInfo::GetUploadData(size_t max_size) const {
+  if (!request_body) {
     return {};
   }
-  const auto* elements = request.request_body->elements();
+
+  const auto* elements = request_body->elements();
+  size_t size = 0;
+  for (const network::DataElement& element : *elements) {
+    if (element.type() == network::mojom::DataElementDataView::Tag::kBytes) {
+      size += element.As<network::DataElementBytes>().bytes().size();
+    }
+  }
+  if (size > max_size) {
+    return {};
+  }
+
+  std::string upload_data;
+  upload_data.reserve(size);
   for (const network::DataElement& element : *elements) {
     if (element.type() == network::mojom::DataElementDataView::Tag::kBytes) {
       const auto& bytes = element.As<network::DataElementBytes>().bytes();
@@ -47,14 +87,6 @@ std::string GetUploadData(const network::ResourceRequest& request) {
   return upload_data;
 }
 
-}  // namespace
-
-BraveRequestInfo::BraveRequestInfo() = default;
-
-BraveRequestInfo::BraveRequestInfo(const GURL& url) : request_url(url) {}
-
-BraveRequestInfo::~BraveRequestInfo() = default;
-
 // static
 std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
     const network::ResourceRequest& request,
@@ -135,23 +167,23 @@ std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
   }
 #endif
 
-  Profile* profile = Profile::FromBrowserContext(browser_context);
-  auto* map = HostContentSettingsMapFactory::GetForProfile(profile);
-  ctx->allow_brave_shields =
-      brave_shields::GetBraveShieldsEnabled(map, ctx->tab_origin);
-  ctx->allow_ads = brave_shields::GetAdControlType(map, ctx->tab_origin) ==
-                   brave_shields::ControlType::ALLOW;
+  auto* shields_decisions = GetShieldsDecisionCache(browser_context);
+  const brave_shields::ShieldsDecisions decisions =
+      shields_decisions->Get(ctx->tab_origin);
+  ctx->allow_brave_shields = decisions.shields_enabled;
+  ctx->allow_ads = decisions.allow_ads;
   ctx->allow_http_upgradable_resource =
-      !brave_shields::GetHTTPSEverywhereEnabled(map, ctx->tab_origin);
+      decisions.allow_http_upgradable_resource;
 
   // HACK: after we fix multiple creations of BraveRequestInfo we should
   // use only tab_origin. Since we recreate BraveRequestInfo during consequent
   // stages of navigation, |tab_origin| changes and so does |allow_referrers|
   // flag, which is not what we want for determining referrers.
-  ctx->allow_referrers = brave_shields::AllowReferrers(
-      map,
-      ctx->redirect_source.is_empty() ? ctx->tab_origin : ctx->redirect_source);
-  ctx->upload_data = GetUploadData(request);
+  ctx->allow_referrers =
+      ctx->redirect_source.is_empty()
+          ? decisions.allow_referrers
+          : shields_decisions->Get(ctx->redirect_source).allow_referrers;
+  ctx->request_body = request.request_body;
 
   ctx->browser_context = browser_context;
 
@@ -0,0 +1,65 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/url_context.h"
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
+#include "services/network/public/cpp/resource_request_body.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+const char kTestUrl[] = "https://brave.com/";
+constexpr size_t kMaxSize = 1024;
+
+void AppendBytes(network::ResourceRequestBody* body, const std::string& data) {
+  body->AppendBytes(data.data(), static_cast<int>(data.size()));
+}
+
+}  // namespace
+
+TEST(BraveRequestInfoTest, NoRequestBody) {
+  brave::BraveRequestInfo ctx((GURL(kTestUrl)));
+  EXPECT_EQ(ctx.GetUploadData(kMaxSize), "");
+}
+
+TEST(BraveRequestInfoTest, JoinsBytesElements) {
+  brave::BraveRequestInfo ctx((GURL(kTestUrl)));
+  ctx.request_body = base::MakeRefCounted<network::ResourceRequestBody>();
+  AppendBytes(ctx.request_body.get(), "event=");
+  AppendBytes(ctx.request_body.get(), "");
+  AppendBytes(ctx.request_body.get(), "minute-watched");
+
+  EXPECT_EQ(ctx.GetUploadData(kMaxSize), "event=minute-watched");
+}
+
+TEST(BraveRequestInfoTest, SkipsNonBytesElements) {
+  brave::BraveRequestInfo ctx((GURL(kTestUrl)));
+  ctx.request_body = base::MakeRefCounted<network::ResourceRequestBody>();
+  AppendBytes(ctx.request_body.get(), "a=1");
+  ctx.request_body->AppendFileRange(base::FilePath(FILE_PATH_LITERAL("file")),
+                                    0, 4096, base::Time());
+  AppendBytes(ctx.request_body.get(), "&b=2");
+
+  EXPECT_EQ(ctx.GetUploadData(kMaxSize), "a=1&b=2");
+}
+
+TEST(BraveRequestInfoTest, CapsUploadDataSize) {
+  brave::BraveRequestInfo ctx((GURL(kTestUrl)));
+  ctx.request_body = base::MakeRefCounted<network::ResourceRequestBody>();
+  AppendBytes(ctx.request_body.get(), std::string(kMaxSize / 2, 'a'));
+  AppendBytes(ctx.request_body.get(), std::string(kMaxSize / 2, 'b'));
+
+  EXPECT_EQ(ctx.GetUploadData(kMaxSize).size(), kMaxSize);
+
+  AppendBytes(ctx.request_body.get(), "c");
+  EXPECT_EQ(ctx.GetUploadData(kMaxSize), "");
+  EXPECT_EQ(ctx.GetUploadData(kMaxSize + 1).size(), kMaxSize + 1);
+}
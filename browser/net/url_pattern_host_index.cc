@@ -0,0 +1,91 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/url_pattern_host_index.h"
+
+#include <algorithm>
+
+#include "base/strings/string_piece.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+URLPatternHostIndex::Entry::Entry(int id,
+                                  const URLPattern& pattern,
+                                  bool match_host_only)
+    : id(id), pattern(pattern), match_host_only(match_host_only) {}
+
+URLPatternHostIndex::Entry::~Entry() = default;
+
+URLPatternHostIndex::Entry::Entry(const Entry&) = default;
+
+URLPatternHostIndex::URLPatternHostIndex() = default;
+
+URLPatternHostIndex::~URLPatternHostIndex() = default;
+
+URLPatternHostIndex::URLPatternHostIndex(URLPatternHostIndex&& other) = default;
+
+URLPatternHostIndex& URLPatternHostIndex::operator=(
+    URLPatternHostIndex&& other) = default;
+
+void URLPatternHostIndex::Add(int id,
+                              const URLPattern& pattern,
+                              bool match_host_only) {
+  const size_t index = entries_.size();
+  entries_.emplace_back(id, pattern, match_host_only);
+
+  if (pattern.host().empty() && pattern.match_subdomains()) {
+    any_host_.push_back(index);
+  } else if (pattern.match_subdomains()) {
+    domain_hosts_[pattern.host()].push_back(index);
+  } else {
+    exact_hosts_[pattern.host()].push_back(index);
+  }
+}
+
+std::vector<int> URLPatternHostIndex::GetMatchingIds(const GURL& url) const {
+  std::vector<int> ids;
+
+  AddCandidates(any_host_, url, &ids);
+
+  base::StringPiece host = url.host_piece();
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+
+  const auto exact_iter = exact_hosts_.find(host);
+  if (exact_iter != exact_hosts_.end())
+    AddCandidates(exact_iter->second, url, &ids);
+
+  // Walk |host| and each of its parent domains, e.g. "a.b.com", "b.com" and
+  // "com"
+  while (!domain_hosts_.empty() && !host.empty()) {
+    const auto domain_iter = domain_hosts_.find(host);
+    if (domain_iter != domain_hosts_.end())
+      AddCandidates(domain_iter->second, url, &ids);
+
+    const size_t pos = host.find('.');
+    if (pos == base::StringPiece::npos)
+      break;
+    host.remove_prefix(pos + 1);
+  }
+
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+void URLPatternHostIndex::AddCandidates(const std::vector<size_t>& candidates,
+                                        const GURL& url,
+                                        std::vector<int>* ids) const {
+  for (const size_t index : candidates) {
+    const Entry& entry = entries_[index];
+    const bool matches = entry.match_host_only
+                             ? entry.pattern.MatchesHost(url)
+                             : entry.pattern.MatchesURL(url);
+    if (matches)
+      ids->push_back(entry.id);
+  }
+}
+
+}  // namespace brave
@@ -0,0 +1,66 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_URL_PATTERN_HOST_INDEX_H_
+#define BRAVE_BROWSER_NET_URL_PATTERN_HOST_INDEX_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace brave {
+
+// Indexes a fixed set of URLPatterns by host so that a request only has to be
+// matched against the patterns whose host could apply to it. Hosts which none
+// of the patterns cover are rejected with at most one lookup per host label.
+class URLPatternHostIndex {
+ public:
+  URLPatternHostIndex();
+  ~URLPatternHostIndex();
+
+  URLPatternHostIndex(URLPatternHostIndex&& other);
+  URLPatternHostIndex& operator=(URLPatternHostIndex&& other);
+
+  // Adds |pattern| under |id|. If |match_host_only| is true only the host of
+  // the pattern is considered, as with URLPattern::MatchesHost.
+  void Add(int id, const URLPattern& pattern, bool match_host_only = false);
+
+  // Returns the ids of all patterns matching |url| in ascending order.
+  std::vector<int> GetMatchingIds(const GURL& url) const;
+
+ private:
+  struct Entry {
+    Entry(int id, const URLPattern& pattern, bool match_host_only);
+    ~Entry();
+    Entry(const Entry&);
+
+    int id;
+    URLPattern pattern;
+    bool match_host_only;
+  };
+
+  using HostMap = base::flat_map<std::string, std::vector<size_t>, std::less<>>;
+
+  void AddCandidates(const std::vector<size_t>& candidates,
+                     const GURL& url,
+                     std::vector<int>* ids) const;
+
+  std::vector<Entry> entries_;
+  // Patterns matching exactly one host.
+  HostMap exact_hosts_;
+  // Patterns matching a host and all of its subdomains.
+  HostMap domain_hosts_;
+  // Patterns matching any host.
+  std::vector<size_t> any_host_;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_URL_PATTERN_HOST_INDEX_H_
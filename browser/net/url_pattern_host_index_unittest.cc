@@ -0,0 +1,135 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/url_pattern_host_index.h"
+
+#include <string>
+#include <vector>
+
+#include "extensions/common/url_pattern.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+const int kHttpAndHttps = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+std::vector<int> GetMatchingIdsSlow(const std::vector<URLPattern>& patterns,
+                                    const GURL& url) {
+  std::vector<int> ids;
+  for (size_t i = 0; i < patterns.size(); ++i) {
+    if (patterns[i].MatchesURL(url))
+      ids.push_back(static_cast<int>(i));
+  }
+  return ids;
+}
+
+}  // namespace
+
+namespace brave {
+
+TEST(URLPatternHostIndexTest, MatchesExactHost) {
+  URLPatternHostIndex index;
+  index.Add(1, URLPattern(kHttpAndHttps, "*://dl.google.com/*"));
+
+  EXPECT_EQ(std::vector<int>({1}),
+            index.GetMatchingIds(GURL("https://dl.google.com/foo")));
+  EXPECT_TRUE(index.GetMatchingIds(GURL("https://a.dl.google.com/")).empty());
+  EXPECT_TRUE(index.GetMatchingIds(GURL("https://google.com/")).empty());
+  EXPECT_TRUE(index.GetMatchingIds(GURL("ftp://dl.google.com/")).empty());
+}
+
+TEST(URLPatternHostIndexTest, MatchesSubdomains) {
+  URLPatternHostIndex index;
+  index.Add(1, URLPattern(kHttpAndHttps, "*://*.gvt1.com/*"));
+
+  EXPECT_EQ(std::vector<int>({1}),
+            index.GetMatchingIds(GURL("https://gvt1.com/")));
+  EXPECT_EQ(std::vector<int>({1}),
+            index.GetMatchingIds(GURL("http://r1---sn.gvt1.com/edgedl/x")));
+  EXPECT_TRUE(index.GetMatchingIds(GURL("https://gvt1.com.evil/")).empty());
+  EXPECT_TRUE(index.GetMatchingIds(GURL("https://notgvt1.com/")).empty());
+}
+
+TEST(URLPatternHostIndexTest, MatchesHostOnly) {
+  URLPatternHostIndex index;
+  index.Add(1,
+            URLPattern(URLPattern::SCHEME_HTTPS,
+                       "https://safebrowsing.googleapis.com/"),
+            /* match_host_only */ true);
+
+  EXPECT_EQ(std::vector<int>({1}),
+            index.GetMatchingIds(
+                GURL("https://safebrowsing.googleapis.com/v4/threatLists")));
+}
+
+TEST(URLPatternHostIndexTest, MatchesAnyHost) {
+  URLPatternHostIndex index;
+  index.Add(1, URLPattern(kHttpAndHttps, "*://*/favicon.ico"));
+
+  EXPECT_EQ(std::vector<int>({1}),
+            index.GetMatchingIds(GURL("https://brave.com/favicon.ico")));
+  EXPECT_TRUE(index.GetMatchingIds(GURL("https://brave.com/")).empty());
+}
+
+TEST(URLPatternHostIndexTest, ReturnsIdsInAscendingOrder) {
+  URLPatternHostIndex index;
+  index.Add(2, URLPattern(kHttpAndHttps, "*://*.google.com/*"));
+  index.Add(1, URLPattern(kHttpAndHttps, "*://dl.google.com/*"));
+  index.Add(0, URLPattern(kHttpAndHttps, "*://*/*"));
+
+  EXPECT_EQ(std::vector<int>({0, 1, 2}),
+            index.GetMatchingIds(GURL("https://dl.google.com/")));
+  EXPECT_EQ(std::vector<int>({0, 2}),
+            index.GetMatchingIds(GURL("https://www.google.com/")));
+}
+
+TEST(URLPatternHostIndexTest, MatchesLikeURLPatterns) {
+  const std::vector<URLPattern> patterns({
+      URLPattern(URLPattern::SCHEME_HTTPS,
+                 "https://www.googleapis.com/geolocation/v1/geolocate?key=*"),
+      URLPattern(kHttpAndHttps,
+                 "*://clients2.googleusercontent.com/crx/blobs/*crx*"),
+      URLPattern(URLPattern::SCHEME_HTTPS,
+                 "https://www.gstatic.com/autofill/*"),
+      URLPattern(kHttpAndHttps,
+                 "*://*.gvt1.com/edgedl/release2/chrome_component/*"),
+      URLPattern(kHttpAndHttps, "*://*.gvt1.com/*"),
+      URLPattern(kHttpAndHttps, "*://dl.google.com/*"),
+      URLPattern(kHttpAndHttps,
+                 "*://bugs.chromium.org/p/chromium/issues/entry?*"),
+  });
+
+  URLPatternHostIndex index;
+  for (size_t i = 0; i < patterns.size(); ++i)
+    index.Add(static_cast<int>(i), patterns[i]);
+
+  const std::vector<std::string> urls({
+      "https://www.googleapis.com/geolocation/v1/geolocate?key=123",
+      "https://www.googleapis.com/geolocation/v2/",
+      "http://clients2.googleusercontent.com/crx/blobs/abc/x.crx",
+      "https://www.gstatic.com/autofill/foo",
+      "https://www.gstatic.com/images/foo.png",
+      "http://r2---sn-n4v7sn7y.gvt1.com/edgedl/release2/chrome_component/x",
+      "https://redirector.gvt1.com/edgedl/chromewebstore/x",
+      "https://dl.google.com/release2/chrome_component/crl-set",
+      "https://bugs.chromium.org/p/chromium/issues/entry?comment=x",
+      "https://brave.com/",
+      "https://www.example.com/index.html",
+      "https://127.0.0.1:8080/",
+      "https://localhost/",
+      "https://dl.google.com./trailing_dot",
+      "file:///etc/passwd",
+      "data:text/plain,gvt1.com",
+  });
+
+  for (const auto& url : urls) {
+    EXPECT_EQ(GetMatchingIdsSlow(patterns, GURL(url)),
+              index.GetMatchingIds(GURL(url)))
+        << url;
+  }
+}
+
+}  // namespace brave
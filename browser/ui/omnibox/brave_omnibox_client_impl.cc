@@ -9,10 +9,11 @@
 
 #include "base/metrics/histogram_macros.h"
 #include "base/stl_util.h"
-#include "base/values.h"
 #include "brave/browser/autocomplete/brave_autocomplete_scheme_classifier.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/weekly_storage/weekly_storage.h"
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
+#include "brave/components/weekly_storage/weekly_storage_registry_factory.h"
 #include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/ui/omnibox/chrome_omnibox_client.h"
 #include "chrome/browser/ui/omnibox/chrome_omnibox_edit_controller.h"
@@ -50,6 +51,11 @@ void RecordSearchEventP3A(uint64_t number_of_searches) {
                              base::size(kIntervals));
 }
 
+WeeklyStorage* GetSearchCountStorage(Profile* profile) {
+  return WeeklyStorageRegistryFactory::GetForBrowserContext(profile)->Get(
+      kSearchCountPrefName);
+}
+
 }  // namespace
 
 BraveOmniboxClientImpl::BraveOmniboxClientImpl(
@@ -58,10 +64,9 @@ BraveOmniboxClientImpl::BraveOmniboxClientImpl(
     : ChromeOmniboxClient(controller, profile),
       profile_(profile),
       scheme_classifier_(profile) {
-  // Record initial search count p3a value.
-  const base::Value* search_p3a =
-      profile_->GetPrefs()->GetList(kSearchCountPrefName);
-  if (search_p3a->GetList().size() == 0) {
+  // Record initial search count p3a value. The shared storage may hold
+  // searches that aren't written to prefs yet.
+  if (GetSearchCountStorage(profile_)->GetWeeklySum() == 0) {
     RecordSearchEventP3A(0);
   }
 }
@@ -83,9 +88,8 @@ bool BraveOmniboxClientImpl::IsAutocompleteEnabled() const {
 
 void BraveOmniboxClientImpl::OnInputAccepted(const AutocompleteMatch& match) {
   if (IsSearchEvent(match)) {
-    // TODO(iefremov): Optimize this.
-    WeeklyStorage storage(profile_->GetPrefs(), kSearchCountPrefName);
-    storage.AddDelta(1);
-    RecordSearchEventP3A(storage.GetWeeklySum());
+    WeeklyStorage* storage = GetSearchCountStorage(profile_);
+    storage->AddDelta(1);
+    RecordSearchEventP3A(storage->GetWeeklySum());
   }
 }
@@ -9,6 +9,13 @@
 #include "components/content_settings/renderer/content_settings_agent_impl.h"
 
 BraveFarblingLevel WorkerContentSettingsClient::GetBraveFarblingLevel() {
+  if (!cached_brave_farbling_level_)
+    cached_brave_farbling_level_ = ComputeBraveFarblingLevel();
+
+  return *cached_brave_farbling_level_;
+}
+
+BraveFarblingLevel WorkerContentSettingsClient::ComputeBraveFarblingLevel() {
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
   if (content_setting_rules_) {
     const GURL& primary_url = top_frame_origin_.GetURL();
@@ -6,9 +6,19 @@
 #ifndef BRAVE_CHROMIUM_SRC_CHROME_RENDERER_WORKER_CONTENT_SETTINGS_CLIENT_H_
 #define BRAVE_CHROMIUM_SRC_CHROME_RENDERER_WORKER_CONTENT_SETTINGS_CLIENT_H_
 
-#define BRAVE_WORKER_CONTENT_SETTINGS_CLIENT_H         \
-  BraveFarblingLevel GetBraveFarblingLevel() override; \
-  bool AllowFingerprinting(bool enabled_per_settings) override;
+#include "base/optional.h"
+
+// The worker's content setting rules are a snapshot taken when it was
+// created, so the farbling level is resolved once per worker.
+#define BRAVE_WORKER_CONTENT_SETTINGS_CLIENT_H                     \
+  BraveFarblingLevel GetBraveFarblingLevel() override;             \
+  bool AllowFingerprinting(bool enabled_per_settings) override;    \
+                                                                   \
+ private:                                                          \
+  BraveFarblingLevel ComputeBraveFarblingLevel();                  \
+  base::Optional<BraveFarblingLevel> cached_brave_farbling_level_; \
+                                                                   \
+ public:
 
 #include "../../../../chrome/renderer/worker_content_settings_client.h"
 
@@ -3,10 +3,25 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include "components/content_settings/core/common/content_settings_mojom_traits.h"
+
+#include "base/atomic_sequence_num.h"
+
+namespace {
+
+bool SetBraveRulesVersion(RendererContentSettingRules* rules) {
+  static base::AtomicSequenceNumber rules_version;
+  rules->brave_rules_version = rules_version.GetNext() + 1;
+  return true;
+}
+
+}  // namespace
+
 #define BRAVE_READ_RENDERER_CONTENT_SETTING_RULES_DATA_VIEW       \
   data.ReadAutoplayRules(&out->autoplay_rules) &&                 \
       data.ReadFingerprintingRules(&out->fingerprinting_rules) && \
-      data.ReadBraveShieldsRules(&out->brave_shields_rules) &&
+      data.ReadBraveShieldsRules(&out->brave_shields_rules) &&    \
+      SetBraveRulesVersion(out) &&
 
 #include "../../../../../../components/content_settings/core/common/content_settings_mojom_traits.cc"
 
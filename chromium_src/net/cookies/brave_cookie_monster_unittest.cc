@@ -0,0 +1,151 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "net/cookies/cookie_monster.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "net/cookies/canonical_cookie.h"
+#include "net/cookies/cookie_deletion_info.h"
+#include "net/cookies/cookie_options.h"
+#include "net/cookies/cookie_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+const char kCookieURL[] = "https://a.com/";
+
+GURL GetTopFrameURL(int index) {
+  return GURL("https://site" + base::NumberToString(index) + ".com/");
+}
+
+}  // namespace
+
+class BraveCookieMonsterTest : public testing::Test {
+ protected:
+  BraveCookieMonsterTest()
+      : cookie_monster_(
+            std::make_unique<CookieMonster>(nullptr /* store */,
+                                            nullptr /* net_log */)) {}
+
+  void SetEphemeralCookie(const std::string& cookie_line,
+                          const GURL& top_frame_url) {
+    const GURL url(kCookieURL);
+    std::unique_ptr<CanonicalCookie> cookie = CanonicalCookie::Create(
+        url, cookie_line, base::Time::Now(), base::nullopt);
+    ASSERT_TRUE(cookie);
+
+    bool called = false;
+    cookie_monster_->SetEphemeralCanonicalCookieAsync(
+        std::move(cookie), url, top_frame_url,
+        CookieOptions::MakeAllInclusive(),
+        base::BindOnce(
+            [](bool* called, CookieAccessResult result) {
+              EXPECT_TRUE(result.status.IsInclude());
+              *called = true;
+            },
+            &called));
+    task_environment_.RunUntilIdle();
+    EXPECT_TRUE(called);
+  }
+
+  CookieList GetEphemeralCookies(const GURL& top_frame_url) {
+    CookieList cookies;
+    cookie_monster_->GetEphemeralCookieListWithOptionsAsync(
+        GURL(kCookieURL), top_frame_url, CookieOptions::MakeAllInclusive(),
+        base::BindOnce(
+            [](CookieList* cookies,
+               const CookieAccessResultList& included_cookies,
+               const CookieAccessResultList& excluded_cookies) {
+              *cookies = cookie_util::StripAccessResults(included_cookies);
+            },
+            &cookies));
+    task_environment_.RunUntilIdle();
+    return cookies;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  std::unique_ptr<CookieMonster> cookie_monster_;
+};
+
+TEST_F(BraveCookieMonsterTest, ReadDoesNotCreateEphemeralStore) {
+  EXPECT_TRUE(GetEphemeralCookies(GetTopFrameURL(0)).empty());
+  EXPECT_EQ(0u, cookie_monster_->ephemeral_cookie_store_count_for_testing());
+
+  SetEphemeralCookie("a=1", GetTopFrameURL(0));
+  EXPECT_EQ(1u, cookie_monster_->ephemeral_cookie_store_count_for_testing());
+  EXPECT_EQ(1u, GetEphemeralCookies(GetTopFrameURL(0)).size());
+}
+
+TEST_F(BraveCookieMonsterTest, EphemeralStoresArePartitionedByTopFrame) {
+  SetEphemeralCookie("a=1", GetTopFrameURL(0));
+  SetEphemeralCookie("b=2", GetTopFrameURL(1));
+
+  const CookieList cookies = GetEphemeralCookies(GetTopFrameURL(0));
+  ASSERT_EQ(1u, cookies.size());
+  EXPECT_EQ("a", cookies[0].Name());
+  EXPECT_TRUE(GetEphemeralCookies(GetTopFrameURL(2)).empty());
+}
+
+TEST_F(BraveCookieMonsterTest, DropEphemeralStore) {
+  SetEphemeralCookie("a=1", GetTopFrameURL(0));
+  SetEphemeralCookie("a=1", GetTopFrameURL(1));
+
+  CookieDeletionInfo delete_info;
+  delete_info.ephemeral_storage_domain = "site0.com";
+  cookie_monster_->DeleteAllMatchingInfoAsync(std::move(delete_info),
+                                              CookieStore::DeleteCallback());
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(1u, cookie_monster_->ephemeral_cookie_store_count_for_testing());
+  EXPECT_TRUE(GetEphemeralCookies(GetTopFrameURL(0)).empty());
+  EXPECT_EQ(1u, GetEphemeralCookies(GetTopFrameURL(1)).size());
+}
+
+TEST_F(BraveCookieMonsterTest, ManyEphemeralStores) {
+  const int kStoreCount = 500;
+  for (int i = 0; i < kStoreCount; ++i)
+    SetEphemeralCookie("a=" + base::NumberToString(i), GetTopFrameURL(i));
+  SetEphemeralCookie("b=1", GetTopFrameURL(0));
+  EXPECT_EQ(static_cast<size_t>(kStoreCount),
+            cookie_monster_->ephemeral_cookie_store_count_for_testing());
+
+  for (int i = 0; i < kStoreCount; ++i) {
+    const CookieList cookies = GetEphemeralCookies(GetTopFrameURL(i));
+    ASSERT_FALSE(cookies.empty());
+    EXPECT_EQ(base::NumberToString(i), cookies[0].Value());
+  }
+
+  // Deleting a single cookie reaches every store that holds it.
+  const CookieList cookies = GetEphemeralCookies(GetTopFrameURL(0));
+  ASSERT_EQ(2u, cookies.size());
+  const CanonicalCookie& cookie =
+      cookies[0].Name() == "b" ? cookies[0] : cookies[1];
+  cookie_monster_->DeleteCanonicalCookieAsync(cookie,
+                                              CookieStore::DeleteCallback());
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(1u, GetEphemeralCookies(GetTopFrameURL(0)).size());
+
+  for (int i = 0; i < kStoreCount; ++i) {
+    CookieDeletionInfo delete_info;
+    delete_info.ephemeral_storage_domain =
+        "site" + base::NumberToString(i) + ".com";
+    cookie_monster_->DeleteAllMatchingInfoAsync(std::move(delete_info),
+                                                CookieStore::DeleteCallback());
+  }
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(0u, cookie_monster_->ephemeral_cookie_store_count_for_testing());
+}
+
+}  // namespace net
@@ -6,6 +6,9 @@
 #include "net/cookies/cookie_monster.h"
 
 #include <memory>
+#include <tuple>
+#include <utility>
+
 #include "net/base/url_util.h"
 
 #define CookieMonster ChromiumCookieMonster
@@ -29,24 +32,59 @@ CookieMonster::CookieMonster(scoped_refptr<PersistentCookieStore> store,
 
 CookieMonster::~CookieMonster() {}
 
-ChromiumCookieMonster*
-CookieMonster::GetOrCreateEphemeralCookieStoreForTopFrameURL(
-    const GURL& top_frame_url) {
-  std::string domain = URLToEphemeralStorageDomain(top_frame_url);
-  auto it = ephemeral_cookie_stores_.find(domain);
+CookieMonster::EphemeralCookieStore::EphemeralCookieStore(
+    std::unique_ptr<ChromiumCookieMonster> store)
+    : store(std::move(store)) {}
+
+CookieMonster::EphemeralCookieStore::~EphemeralCookieStore() = default;
+
+CookieMonster::EphemeralCookieStore*
+CookieMonster::GetOrCreateEphemeralCookieStore(
+    const std::string& ephemeral_storage_domain) {
+  auto it = ephemeral_cookie_stores_.find(ephemeral_storage_domain);
   if (it != ephemeral_cookie_stores_.end())
-    return it->second.get();
+    return &it->second;
 
-  return ephemeral_cookie_stores_
-      .emplace(domain, new ChromiumCookieMonster(nullptr /* store */,
-                                                 net_log_.net_log()))
-      .first->second.get();
+  auto store = std::make_unique<ChromiumCookieMonster>(nullptr /* store */,
+                                                       net_log_.net_log());
+  if (cookieable_schemes_) {
+    store->SetCookieableSchemes(*cookieable_schemes_,
+                                SetCookieableSchemesCallback());
+  }
+  return &ephemeral_cookie_stores_
+              .emplace(std::piecewise_construct,
+                       std::forward_as_tuple(ephemeral_storage_domain),
+                       std::forward_as_tuple(std::move(store)))
+              .first->second;
+}
+
+void CookieMonster::DropEphemeralCookieStore(
+    const std::string& ephemeral_storage_domain) {
+  auto it = ephemeral_cookie_stores_.find(ephemeral_storage_domain);
+  if (it == ephemeral_cookie_stores_.end())
+    return;
+
+  for (const auto& cookie_domain : it->second.cookie_domains) {
+    auto domains_it =
+        ephemeral_storage_domains_by_cookie_domain_.find(cookie_domain);
+    if (domains_it == ephemeral_storage_domains_by_cookie_domain_.end())
+      continue;
+    domains_it->second.erase(ephemeral_storage_domain);
+    if (domains_it->second.empty())
+      ephemeral_storage_domains_by_cookie_domain_.erase(domains_it);
+  }
+  ephemeral_cookie_stores_.erase(it);
 }
 
 void CookieMonster::DeleteCanonicalCookieAsync(const CanonicalCookie& cookie,
                                                DeleteCallback callback) {
-  for (auto& it : ephemeral_cookie_stores_) {
-    it.second->DeleteCanonicalCookieAsync(cookie, DeleteCallback());
+  auto domains_it =
+      ephemeral_storage_domains_by_cookie_domain_.find(cookie.Domain());
+  if (domains_it != ephemeral_storage_domains_by_cookie_domain_.end()) {
+    for (const auto& ephemeral_storage_domain : domains_it->second) {
+      ephemeral_cookie_stores_.at(ephemeral_storage_domain)
+          .store->DeleteCanonicalCookieAsync(cookie, DeleteCallback());
+    }
   }
   ChromiumCookieMonster::DeleteCanonicalCookieAsync(cookie,
                                                     std::move(callback));
@@ -56,8 +94,8 @@ void CookieMonster::DeleteAllCreatedInTimeRangeAsync(
     const CookieDeletionInfo::TimeRange& creation_range,
     DeleteCallback callback) {
   for (auto& it : ephemeral_cookie_stores_) {
-    it.second->DeleteAllCreatedInTimeRangeAsync(creation_range,
-                                                DeleteCallback());
+    it.second.store->DeleteAllCreatedInTimeRangeAsync(creation_range,
+                                                      DeleteCallback());
   }
   ChromiumCookieMonster::DeleteAllCreatedInTimeRangeAsync(creation_range,
                                                           std::move(callback));
@@ -66,13 +104,13 @@ void CookieMonster::DeleteAllCreatedInTimeRangeAsync(
 void CookieMonster::DeleteAllMatchingInfoAsync(CookieDeletionInfo delete_info,
                                                DeleteCallback callback) {
   if (delete_info.ephemeral_storage_domain.has_value()) {
-    ephemeral_cookie_stores_.erase(*delete_info.ephemeral_storage_domain);
+    DropEphemeralCookieStore(*delete_info.ephemeral_storage_domain);
     std::move(callback).Run(0);
     return;
   }
 
   for (auto& it : ephemeral_cookie_stores_) {
-    it.second->DeleteAllMatchingInfoAsync(delete_info, DeleteCallback());
+    it.second.store->DeleteAllMatchingInfoAsync(delete_info, DeleteCallback());
   }
   ChromiumCookieMonster::DeleteAllMatchingInfoAsync(delete_info,
                                                     std::move(callback));
@@ -80,7 +118,7 @@ void CookieMonster::DeleteAllMatchingInfoAsync(CookieDeletionInfo delete_info,
 
 void CookieMonster::DeleteSessionCookiesAsync(DeleteCallback callback) {
   for (auto& it : ephemeral_cookie_stores_) {
-    it.second->DeleteSessionCookiesAsync(DeleteCallback());
+    it.second.store->DeleteSessionCookiesAsync(DeleteCallback());
   }
   ChromiumCookieMonster::DeleteSessionCookiesAsync(std::move(callback));
 }
@@ -88,8 +126,10 @@ void CookieMonster::DeleteSessionCookiesAsync(DeleteCallback callback) {
 void CookieMonster::SetCookieableSchemes(
     const std::vector<std::string>& schemes,
     SetCookieableSchemesCallback callback) {
+  cookieable_schemes_ = schemes;
   for (auto& it : ephemeral_cookie_stores_) {
-    it.second->SetCookieableSchemes(schemes, SetCookieableSchemesCallback());
+    it.second.store->SetCookieableSchemes(schemes,
+                                          SetCookieableSchemesCallback());
   }
   ChromiumCookieMonster::SetCookieableSchemes(schemes, std::move(callback));
 }
@@ -99,10 +139,15 @@ void CookieMonster::GetEphemeralCookieListWithOptionsAsync(
     const GURL& top_frame_url,
     const CookieOptions& options,
     GetCookieListCallback callback) {
-  ChromiumCookieMonster* ephemeral_monster =
-      GetOrCreateEphemeralCookieStoreForTopFrameURL(top_frame_url);
-  ephemeral_monster->GetCookieListWithOptionsAsync(url, options,
-                                                   std::move(callback));
+  auto it = ephemeral_cookie_stores_.find(
+      URLToEphemeralStorageDomain(top_frame_url));
+  if (it == ephemeral_cookie_stores_.end()) {
+    // Nothing was ever set for this top frame, so there is nothing to return.
+    std::move(callback).Run({}, {});
+    return;
+  }
+  it->second.store->GetCookieListWithOptionsAsync(url, options,
+                                                  std::move(callback));
 }
 
 void CookieMonster::SetEphemeralCanonicalCookieAsync(
@@ -111,10 +156,16 @@ void CookieMonster::SetEphemeralCanonicalCookieAsync(
     const GURL& top_frame_url,
     const CookieOptions& options,
     SetCookiesCallback callback) {
-  ChromiumCookieMonster* ephemeral_monster =
-      GetOrCreateEphemeralCookieStoreForTopFrameURL(top_frame_url);
-  ephemeral_monster->SetCanonicalCookieAsync(std::move(cookie), source_url,
-                                             options, std::move(callback));
+  const std::string ephemeral_storage_domain =
+      URLToEphemeralStorageDomain(top_frame_url);
+  EphemeralCookieStore* ephemeral_store =
+      GetOrCreateEphemeralCookieStore(ephemeral_storage_domain);
+  if (ephemeral_store->cookie_domains.insert(cookie->Domain()).second) {
+    ephemeral_storage_domains_by_cookie_domain_[cookie->Domain()].insert(
+        ephemeral_storage_domain);
+  }
+  ephemeral_store->store->SetCanonicalCookieAsync(
+      std::move(cookie), source_url, options, std::move(callback));
 }
 
 }  // namespace net
@@ -6,6 +6,9 @@
 #ifndef BRAVE_CHROMIUM_SRC_NET_COOKIES_COOKIE_MONSTER_H_
 #define BRAVE_CHROMIUM_SRC_NET_COOKIES_COOKIE_MONSTER_H_
 
+#include <set>
+#include <unordered_map>
+
 #define CookieMonster ChromiumCookieMonster
 #include "../../../../net/cookies/cookie_monster.h"
 #undef CookieMonster
@@ -47,12 +50,37 @@ class NET_EXPORT CookieMonster : public ChromiumCookieMonster {
                                         const CookieOptions& options,
                                         SetCookiesCallback callback);
 
+  size_t ephemeral_cookie_store_count_for_testing() const {
+    return ephemeral_cookie_stores_.size();
+  }
+
  private:
+  // In-memory cookie store for the ephemeral storage domain of a top frame.
+  struct EphemeralCookieStore {
+    explicit EphemeralCookieStore(std::unique_ptr<ChromiumCookieMonster> store);
+    ~EphemeralCookieStore();
+
+    std::unique_ptr<ChromiumCookieMonster> store;
+    // Domains of the cookies that were ever set in |store|.
+    std::set<std::string> cookie_domains;
+  };
+
+  EphemeralCookieStore* GetOrCreateEphemeralCookieStore(
+      const std::string& ephemeral_storage_domain);
+  void DropEphemeralCookieStore(const std::string& ephemeral_storage_domain);
+
   NetLogWithSource net_log_;
-  std::map<std::string, std::unique_ptr<ChromiumCookieMonster>>
+  // Ephemeral stores are created on the first write for their domain, so
+  // reads from top frames that never set a cookie don't allocate one.
+  std::unordered_map<std::string, EphemeralCookieStore>
       ephemeral_cookie_stores_;
-  ChromiumCookieMonster* GetOrCreateEphemeralCookieStoreForTopFrameURL(
-      const GURL& top_frame_url);
+  // Maps a cookie domain to the ephemeral storage domains whose store may
+  // hold cookies for it, so deleting a single cookie doesn't visit every
+  // ephemeral store.
+  std::unordered_map<std::string, std::set<std::string>>
+      ephemeral_storage_domains_by_cookie_domain_;
+  // Schemes passed to SetCookieableSchemes, applied to stores created later.
+  base::Optional<std::vector<std::string>> cookieable_schemes_;
 };
 
 }  // namespace net
@@ -12,8 +12,8 @@
 #include "base/metrics/histogram_functions.h"
 #include "brave/components/brave_ads/common/pref_names.h"
 #include "brave/components/weekly_storage/weekly_storage.h"
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
 #include "components/prefs/pref_registry_simple.h"
-#include "components/prefs/pref_service.h"
 
 namespace brave_ads {
 namespace {
@@ -94,16 +94,17 @@ void RegisterP2APrefs(PrefRegistrySimple* registry) {
   }
 }
 
-void RecordInWeeklyStorageAndEmitP2AHistogramAnswer(PrefService* prefs,
-                                                    const std::string& name) {
+void RecordInWeeklyStorageAndEmitP2AHistogramAnswer(
+    WeeklyStorageRegistry* weekly_storage_registry,
+    const std::string& name) {
   std::string pref_path(prefs::kP2AStoragePrefNamePrefix);
   pref_path.append(name);
-  if (!prefs->FindPreference(pref_path)) {
+  WeeklyStorage* storage = weekly_storage_registry->Get(pref_path);
+  if (!storage) {
     return;
   }
-  WeeklyStorage storage(prefs, pref_path.c_str());
-  storage.AddDelta(1);
-  EmitP2AHistogramAnswer(name, storage.GetWeeklySum());
+  storage->AddDelta(1);
+  EmitP2AHistogramAnswer(name, storage->GetWeeklySum());
 }
 
 void EmitP2AHistogramAnswer(const std::string& name, uint16_t count_value) {
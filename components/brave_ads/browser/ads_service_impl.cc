@@ -13,6 +13,7 @@
 #include "base/command_line.h"
 #include "base/containers/flat_map.h"
 #include "base/feature_list.h"
+#include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/important_file_writer.h"
@@ -59,6 +60,7 @@
 #include "brave/components/rpill/common/rpill.h"
 #include "brave/components/services/bat_ads/public/cpp/ads_client_mojo_bridge.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
+#include "brave/components/weekly_storage/weekly_storage_registry_factory.h"
 #include "brave/grit/brave_generated_resources.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/notifications/notification_display_service.h"
@@ -149,6 +151,10 @@ std::string LoadOnFileTaskRunner(const base::FilePath& path) {
   return data;
 }
 
+base::File OpenOnFileTaskRunner(const base::FilePath& path) {
+  return base::File(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+}
+
 bool EnsureBaseDirectoryExistsOnFileTaskRunner(const base::FilePath& path) {
   if (base::DirectoryExists(path)) {
     return true;
@@ -1296,6 +1302,16 @@ void AdsServiceImpl::OnLoaded(const ads::LoadCallback& callback,
     callback(ads::Result::SUCCESS, value);
 }
 
+void AdsServiceImpl::OnOpenedUserModelFile(
+    const ads::LoadFileCallback& callback,
+    base::File file) {
+  if (!connected()) {
+    return;
+  }
+
+  callback(std::move(file));
+}
+
 void AdsServiceImpl::OnSaved(const ads::ResultCallback& callback,
                              const bool success) {
   if (!connected()) {
@@ -1846,20 +1862,28 @@ void AdsServiceImpl::Save(const std::string& name,
 
 void AdsServiceImpl::LoadUserModelForId(const std::string& id,
                                         ads::LoadCallback callback) {
+  // User models are passed to the ads process as files, see
+  // |LoadUserModelFileForId|
+  NOTREACHED();
+  callback(ads::Result::FAILED, "");
+}
+
+void AdsServiceImpl::LoadUserModelFileForId(const std::string& id,
+                                            ads::LoadFileCallback callback) {
   const base::Optional<base::FilePath> path =
       g_brave_browser_process->user_model_file_service()->GetPathForId(id);
 
   if (!path) {
-    callback(ads::Result::FAILED, "");
+    callback(base::File());
     return;
   }
 
-  VLOG(1) << "Loading user model from " << path.value();
+  VLOG(1) << "Opening user model " << path.value();
 
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
-      base::BindOnce(&LoadOnFileTaskRunner, path.value()),
-      base::BindOnce(&AdsServiceImpl::OnLoaded, AsWeakPtr(),
+      base::BindOnce(&OpenOnFileTaskRunner, path.value()),
+      base::BindOnce(&AdsServiceImpl::OnOpenedUserModelFile, AsWeakPtr(),
                      std::move(callback)));
 }
 
@@ -1878,8 +1902,10 @@ void AdsServiceImpl::RecordP2AEvent(const std::string& name,
         break;
       }
 
+      WeeklyStorageRegistry* weekly_storage_registry =
+          WeeklyStorageRegistryFactory::GetForBrowserContext(profile_);
       for (auto& item : *list) {
-        RecordInWeeklyStorageAndEmitP2AHistogramAnswer(profile_->GetPrefs(),
+        RecordInWeeklyStorageAndEmitP2AHistogramAnswer(weekly_storage_registry,
                                                        item.GetString());
       }
       break;
@@ -264,6 +264,8 @@ class AdsServiceImpl : public AdsService,
                       const bool flagged);
 
   void OnLoaded(const ads::LoadCallback& callback, const std::string& value);
+  void OnOpenedUserModelFile(const ads::LoadFileCallback& callback,
+                             base::File file);
   void OnSaved(const ads::ResultCallback& callback, const bool success);
 
   void OnRunDBTransaction(ads::RunDBTransactionCallback callback,
@@ -332,6 +334,9 @@ class AdsServiceImpl : public AdsService,
   void LoadUserModelForId(const std::string& id,
                           ads::LoadCallback callback) override;
 
+  void LoadUserModelFileForId(const std::string& id,
+                              ads::LoadFileCallback callback) override;
+
   std::string LoadResourceForId(const std::string& id) override;
 
   void RunDBTransaction(ads::DBTransactionPtr transaction,
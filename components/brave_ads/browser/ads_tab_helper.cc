@@ -6,10 +6,13 @@
 #include "brave/components/brave_ads/browser/ads_tab_helper.h"
 
 #include <memory>
+#include <string>
 #include <utility>
 
+#include "base/strings/stringprintf.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/browser/ads_service_factory.h"
+#include "brave/components/brave_ads/common/features.h"
 #include "chrome/browser/profiles/profile.h"
 #include "components/dom_distiller/content/browser/distiller_javascript_utils.h"
 #include "components/dom_distiller/content/browser/distiller_page_web_contents.h"
@@ -28,6 +31,80 @@
 
 namespace brave_ads {
 
+namespace {
+
+// Walks the rendered text nodes of the page until |max_length| characters
+// have been collected, so that large pages do not produce multi-megabyte
+// strings like |document.body.innerText| does. Like |innerText|, text inside
+// non-rendered, hidden or SVG elements is skipped
+const char kExtractPageTextScript[] = R"(
+  (function(maxLength) {
+    if (!document.body) {
+      return '';
+    }
+
+    const kSkippedElements =
+        new Set(['SCRIPT', 'STYLE', 'NOSCRIPT', 'TEMPLATE']);
+
+    const kSvgNamespace = 'http://www.w3.org/2000/svg';
+
+    // Elements are visited before their text, so the style of each element
+    // is computed once and subtrees that aren't rendered are never entered.
+    // Visibility is inherited, but descendants can override it, so it is
+    // kept per element for its own text nodes
+    const hasVisibleText = new WeakMap();
+
+    const bodyStyle = window.getComputedStyle(document.body);
+    if (bodyStyle.display === 'none') {
+      return '';
+    }
+    hasVisibleText.set(document.body, bodyStyle.visibility === 'visible');
+
+    const walker = document.createTreeWalker(document.body,
+        NodeFilter.SHOW_ELEMENT | NodeFilter.SHOW_TEXT, {
+          acceptNode: function(node) {
+            if (node.nodeType === Node.TEXT_NODE) {
+              return hasVisibleText.get(node.parentElement)
+                  ? NodeFilter.FILTER_ACCEPT : NodeFilter.FILTER_REJECT;
+            }
+
+            if (kSkippedElements.has(node.nodeName.toUpperCase()) ||
+                node.namespaceURI === kSvgNamespace) {
+              return NodeFilter.FILTER_REJECT;
+            }
+
+            const style = window.getComputedStyle(node);
+            if (style.display === 'none') {
+              return NodeFilter.FILTER_REJECT;
+            }
+
+            hasVisibleText.set(node, style.visibility === 'visible');
+            return NodeFilter.FILTER_SKIP;
+          }
+        });
+
+    const values = [];
+    let length = 0;
+    while (length < maxLength && walker.nextNode()) {
+      const value = walker.currentNode.nodeValue.replace(/\s+/g, ' ').trim();
+      if (!value) {
+        continue;
+      }
+
+      values.push(value);
+      length += value.length + 1;
+    }
+
+    return values.join(' ').substring(0, maxLength);
+  })(%d)
+)";
+
+std::string GetExtractPageTextScript(const int max_length) {
+  return base::StringPrintf(kExtractPageTextScript, max_length);
+}
+
+}  // namespace
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       tab_id_(sessions::SessionTabHelper::IdForTab(web_contents)),
@@ -57,6 +134,12 @@ AdsTabHelper::~AdsTabHelper() {
 #endif
 }
 
+// static
+std::string AdsTabHelper::GetExtractPageTextScriptForTesting(
+    const int max_length) {
+  return GetExtractPageTextScript(max_length);
+}
+
 bool AdsTabHelper::IsAdsEnabled() const {
   if (!ads_service_ || !ads_service_->IsEnabled()) {
     return false;
@@ -78,8 +161,13 @@ void AdsTabHelper::RunIsolatedJavaScript(
     content::RenderFrameHost* render_frame_host) {
   DCHECK(render_frame_host);
 
+  const std::string script =
+      base::FeatureList::IsEnabled(features::kPageTextExtraction)
+          ? GetExtractPageTextScript(features::GetPageTextMaxLength())
+          : "document.body.innerText";
+
   dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "document.body.innerText",
+      render_frame_host, script,
       base::BindOnce(&AdsTabHelper::OnJavaScriptResult,
                      weak_factory_.GetWeakPtr()));
 }
@@ -52,6 +52,10 @@ class AdsTabHelper : public content::WebContentsObserver,
   AdsTabHelper(const AdsTabHelper&) = delete;
   AdsTabHelper& operator=(const AdsTabHelper&) = delete;
 
+  // Returns the script that extracts up to |max_length| characters of the
+  // rendered page text.
+  static std::string GetExtractPageTextScriptForTesting(const int max_length);
+
  private:
   friend class content::WebContentsUserData<AdsTabHelper>;
 
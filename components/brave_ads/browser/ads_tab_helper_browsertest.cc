@@ -0,0 +1,66 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "base/path_service.h"
+#include "brave/common/brave_paths.h"
+#include "brave/components/brave_ads/browser/ads_tab_helper.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
+#include "chrome/common/chrome_isolated_world_ids.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "net/test/embedded_test_server/embedded_test_server.h"
+
+// npm run test -- brave_browser_tests --filter=AdsTabHelperBrowserTest.*
+
+namespace brave_ads {
+
+class AdsTabHelperBrowserTest : public InProcessBrowserTest {
+ public:
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+
+    brave::RegisterPathProvider();
+    base::FilePath test_data_dir;
+    base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
+    embedded_test_server()->ServeFilesFromDirectory(test_data_dir);
+    ASSERT_TRUE(embedded_test_server()->Start());
+  }
+
+  // Runs the page text script the way the tab helper does, in an isolated
+  // world of the active tab.
+  std::string ExtractPageText(const int max_length) {
+    content::WebContents* web_contents =
+        browser()->tab_strip_model()->GetActiveWebContents();
+    return content::EvalJs(
+               web_contents,
+               AdsTabHelper::GetExtractPageTextScriptForTesting(max_length),
+               content::EXECUTE_SCRIPT_DEFAULT_OPTIONS,
+               ISOLATED_WORLD_ID_CHROME_INTERNAL)
+        .ExtractString();
+  }
+};
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, ExtractsRenderedText) {
+  ui_test_utils::NavigateToURL(
+      browser(), embedded_test_server()->GetURL("/brave_ads/page_text.html"));
+
+  EXPECT_EQ("Visible paragraph Visible override Last paragraph",
+            ExtractPageText(1024));
+}
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, StopsAtMaxLength) {
+  ui_test_utils::NavigateToURL(
+      browser(), embedded_test_server()->GetURL("/brave_ads/page_text.html"));
+
+  EXPECT_EQ("Visible pa", ExtractPageText(10));
+}
+
+}  // namespace brave_ads
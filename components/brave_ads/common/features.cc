@@ -0,0 +1,31 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/common/features.h"
+
+#include "base/metrics/field_trial_params.h"
+
+namespace brave_ads {
+namespace features {
+
+namespace {
+
+const char kFieldTrialParameterPageTextMaxLength[] = "page_text_max_length";
+
+const int kDefaultPageTextMaxLength = 32 * 1024;
+
+}  // namespace
+
+const base::Feature kPageTextExtraction{"PageTextExtraction",
+                                        base::FEATURE_ENABLED_BY_DEFAULT};
+
+int GetPageTextMaxLength() {
+  return GetFieldTrialParamByFeatureAsInt(kPageTextExtraction,
+                                          kFieldTrialParameterPageTextMaxLength,
+                                          kDefaultPageTextMaxLength);
+}
+
+}  // namespace features
+}  // namespace brave_ads
@@ -0,0 +1,25 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_ADS_COMMON_FEATURES_H_
+#define BRAVE_COMPONENTS_BRAVE_ADS_COMMON_FEATURES_H_
+
+#include "base/feature_list.h"
+
+namespace brave_ads {
+namespace features {
+
+// Extracts a bounded amount of rendered page text for text classification.
+// When disabled, the whole |document.body.innerText| is extracted instead
+extern const base::Feature kPageTextExtraction;
+
+// Maximum number of characters of page text extracted for text
+// classification
+int GetPageTextMaxLength();
+
+}  // namespace features
+}  // namespace brave_ads
+
+#endif  // BRAVE_COMPONENTS_BRAVE_ADS_COMMON_FEATURES_H_
@@ -7,23 +7,17 @@
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_P3A_BANDWIDTH_SAVINGS_TRACKER_H_
 
 #include <cstdint>
-#include <memory>
 
 class PrefRegistrySimple;
-class PrefService;
-
-namespace base {
-class Clock;
-}  // namespace base
+class WeeklyStorage;
 
 namespace brave_perf_predictor {
 
 class P3ABandwidthSavingsTracker {
  public:
-  explicit P3ABandwidthSavingsTracker(PrefService* user_prefs);
-  // Constructor with injected clock for testing
-  P3ABandwidthSavingsTracker(PrefService* user_prefs,
-                             std::unique_ptr<base::Clock> clock);
+  // |savings_storage| is the shared storage backed by
+  // |prefs::kBandwidthSavedDailyBytes|.
+  explicit P3ABandwidthSavingsTracker(WeeklyStorage* savings_storage);
   ~P3ABandwidthSavingsTracker();
   P3ABandwidthSavingsTracker(const P3ABandwidthSavingsTracker&) = delete;
   P3ABandwidthSavingsTracker& operator=(const P3ABandwidthSavingsTracker&) =
@@ -33,8 +27,7 @@ class P3ABandwidthSavingsTracker {
   void RecordSavings(uint64_t savings);
 
  private:
-  PrefService* user_prefs_;
-  std::unique_ptr<base::Clock> clock_;  // Injected clock for testing
+  WeeklyStorage* savings_storage_;
   void StoreSavingsHistogram(uint64_t savings_bytes);
 };
 
@@ -11,6 +11,8 @@
 #include "base/test/metrics/histogram_tester.h"
 #include "base/test/simple_test_clock.h"
 #include "base/time/time.h"
+#include "brave/components/brave_perf_predictor/common/pref_names.h"
+#include "brave/components/weekly_storage/weekly_storage.h"
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -23,14 +25,17 @@ class P3ABandwidthSavingsTrackerTest : public ::testing::Test {
  public:
   P3ABandwidthSavingsTrackerTest() : clock_(new base::SimpleTestClock) {
     P3ABandwidthSavingsTracker::RegisterPrefs(pref_service_.registry());
-    tracker_ = std::make_unique<P3ABandwidthSavingsTracker>(
-        &pref_service_, std::unique_ptr<base::Clock>(clock_));
+    storage_ = std::make_unique<WeeklyStorage>(
+        &pref_service_, prefs::kBandwidthSavedDailyBytes,
+        std::unique_ptr<base::Clock>(clock_));
+    tracker_ = std::make_unique<P3ABandwidthSavingsTracker>(storage_.get());
     clock_->SetNow(base::Time::Now());
   }
 
  protected:
   base::SimpleTestClock* clock_;
   TestingPrefServiceSimple pref_service_;
+  std::unique_ptr<WeeklyStorage> storage_;
   std::unique_ptr<P3ABandwidthSavingsTracker> tracker_;
 };
 
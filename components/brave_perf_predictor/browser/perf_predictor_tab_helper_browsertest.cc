@@ -3,8 +3,11 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <string>
+
 #include "base/path_service.h"
 #include "base/task/post_task.h"
+#include "base/task/thread_pool/thread_pool_instance.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/brave_paths.h"
@@ -61,6 +64,16 @@ class PerfPredictorTabHelperTest : public InProcessBrowserTest {
 
   void TearDown() override { InProcessBrowserTest::TearDown(); }
 
+  void UpdateCustomFilters(const std::string& custom_filters) {
+    ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
+                    ->UpdateCustomFilters(custom_filters));
+    // Let the engine compile and be swapped in before navigating.
+    base::ThreadPoolInstance::Get()->FlushForTesting();
+    scoped_refptr<base::ThreadTestHelper> tr_helper(new base::ThreadTestHelper(
+        g_brave_browser_process->local_data_files_service()->GetTaskRunner()));
+    ASSERT_TRUE(tr_helper->Run());
+  }
+
   void InitEmbeddedTestServer() {
     brave::RegisterPathProvider();
     base::FilePath test_data_dir;
@@ -89,8 +102,7 @@ IN_PROC_BROWSER_TEST_F(PerfPredictorTabHelperTest, NoBlockNoSavings) {
 }
 
 IN_PROC_BROWSER_TEST_F(PerfPredictorTabHelperTest, ScriptBlockHasSavings) {
-  ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
-                  ->UpdateCustomFilters("*analytics.js"));
+  UpdateCustomFilters("*analytics.js");
   EXPECT_EQ(getProfileBandwidthSaved(browser()), 0ULL);
 
   GURL url = embedded_test_server()->GetURL("/blocking.html");
@@ -110,8 +122,7 @@ IN_PROC_BROWSER_TEST_F(PerfPredictorTabHelperTest, ScriptBlockHasSavings) {
 }
 
 IN_PROC_BROWSER_TEST_F(PerfPredictorTabHelperTest, NewNavigationStoresSavings) {
-  ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
-                  ->UpdateCustomFilters("*analytics.js"));
+  UpdateCustomFilters("*analytics.js");
   EXPECT_EQ(getProfileBandwidthSaved(browser()), 0ULL);
 
   GURL url = embedded_test_server()->GetURL("/blocking.html");
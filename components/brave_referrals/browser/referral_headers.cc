@@ -0,0 +1,89 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_referrals/browser/referral_headers.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "base/values.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+ReferralHeaders::ReferralHeaders(const base::Value& referral_headers_list) {
+  if (!referral_headers_list.is_list())
+    return;
+
+  for (const auto& headers_value : referral_headers_list.GetList()) {
+    const base::Value* domains_list =
+        headers_value.FindKeyOfType("domains", base::Value::Type::LIST);
+    if (!domains_list) {
+      LOG(WARNING) << "Failed to retrieve 'domains' key from referral headers";
+      continue;
+    }
+    const base::Value* headers_dict =
+        headers_value.FindKeyOfType("headers", base::Value::Type::DICTIONARY);
+    if (!headers_dict) {
+      LOG(WARNING) << "Failed to retrieve 'headers' key from referral headers";
+      continue;
+    }
+
+    Headers headers;
+    for (const auto& it : headers_dict->DictItems()) {
+      if (it.second.is_string())
+        headers[it.first] = it.second.GetString();
+    }
+
+    const size_t index = headers_.size();
+    headers_.push_back(std::move(headers));
+
+    for (const auto& domain_value : domains_list->GetList()) {
+      if (!domain_value.is_string())
+        continue;
+      // Entries earlier in the list take precedence, so keep the first one
+      domains_.emplace(base::ToLowerASCII(domain_value.GetString()), index);
+    }
+  }
+}
+
+ReferralHeaders::~ReferralHeaders() = default;
+
+const ReferralHeaders::Headers* ReferralHeaders::GetMatchingHeaders(
+    const GURL& url) const {
+  if (domains_.empty() || !url.SchemeIsHTTPOrHTTPS())
+    return nullptr;
+
+  base::StringPiece host = url.host_piece();
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+
+  // Walk |host| and each of its parent domains, e.g. "www.a.com", "a.com" and
+  // "com", keeping the match from the earliest entry in the list
+  size_t match = headers_.size();
+  std::string domain;
+  while (true) {
+    domain.assign(host.data(), host.size());
+    const auto iter = domains_.find(domain);
+    if (iter != domains_.end())
+      match = std::min(match, iter->second);
+
+    if (host.empty())
+      break;
+    const size_t pos = host.find('.');
+    host = pos == base::StringPiece::npos ? base::StringPiece()
+                                          : host.substr(pos + 1);
+  }
+
+  if (match == headers_.size())
+    return nullptr;
+
+  return &headers_[match];
+}
+
+}  // namespace brave
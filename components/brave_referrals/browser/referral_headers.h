@@ -0,0 +1,51 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_H_
+#define BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/macros.h"
+
+class GURL;
+
+namespace base {
+class Value;
+}
+
+namespace brave {
+
+// Immutable, pre-compiled form of the referral headers list stored in
+// |kReferralHeaders|. Each partner domain is indexed by host so matching a
+// request only walks the request host and its parent domains.
+class ReferralHeaders {
+ public:
+  using Headers = base::flat_map<std::string, std::string>;
+
+  explicit ReferralHeaders(const base::Value& referral_headers_list);
+  ~ReferralHeaders();
+
+  // Returns the headers of the first entry in the list with a domain matching
+  // |url| or one of its parent domains, or nullptr if there is none.
+  const Headers* GetMatchingHeaders(const GURL& url) const;
+
+  bool empty() const { return headers_.empty(); }
+
+ private:
+  std::vector<Headers> headers_;
+  // Maps each domain to the index of the first entry in |headers_| that
+  // lists it.
+  std::unordered_map<std::string, size_t> domains_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReferralHeaders);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_H_
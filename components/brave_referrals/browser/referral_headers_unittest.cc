@@ -0,0 +1,127 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_referrals/browser/referral_headers.h"
+
+#include <memory>
+#include <string>
+
+#include "base/json/json_reader.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+const char kTestReferralHeaders[] = R"(
+  [
+    {
+      "domains": [
+         "marketwatch.com",
+         "barrons.com"
+      ],
+      "headers": {
+         "X-Brave-Partner":"dowjones",
+         "X-Invalid": "test"
+      }
+    },
+    {
+      "headers": {
+         "X-Brave-Partner":"nodomains"
+      }
+    },
+    {
+      "domains": [
+         "townsquareblogs.com",
+         "www.barrons.com",
+         "Popcrush.com"
+      ],
+      "headers": {
+         "X-Brave-Partner":"townsquare"
+      }
+    },
+    {
+      "domains": [
+         "xxlmag.com"
+      ]
+    }
+  ])";
+
+std::string GetPartner(const ReferralHeaders& referral_headers,
+                       const std::string& url) {
+  const ReferralHeaders::Headers* headers =
+      referral_headers.GetMatchingHeaders(GURL(url));
+  if (!headers)
+    return std::string();
+
+  const auto iter = headers->find("X-Brave-Partner");
+  return iter != headers->end() ? iter->second : std::string();
+}
+
+}  // namespace
+
+class ReferralHeadersTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    base::Optional<base::Value> value =
+        base::JSONReader::Read(kTestReferralHeaders);
+    ASSERT_TRUE(value);
+    referral_headers_ = std::make_unique<ReferralHeaders>(*value);
+  }
+
+  std::unique_ptr<ReferralHeaders> referral_headers_;
+};
+
+TEST_F(ReferralHeadersTest, MatchesDomain) {
+  EXPECT_EQ("dowjones",
+            GetPartner(*referral_headers_, "https://marketwatch.com/"));
+  EXPECT_EQ("townsquare",
+            GetPartner(*referral_headers_, "http://townsquareblogs.com/a"));
+}
+
+TEST_F(ReferralHeadersTest, MatchesSubdomains) {
+  EXPECT_EQ("dowjones",
+            GetPartner(*referral_headers_, "https://www.marketwatch.com/"));
+  EXPECT_EQ("dowjones",
+            GetPartner(*referral_headers_, "https://a.b.marketwatch.com./"));
+}
+
+TEST_F(ReferralHeadersTest, MatchesCaseInsensitively) {
+  EXPECT_EQ("townsquare",
+            GetPartner(*referral_headers_, "https://popcrush.com/"));
+}
+
+TEST_F(ReferralHeadersTest, EarlierEntriesTakePrecedence) {
+  EXPECT_EQ("dowjones",
+            GetPartner(*referral_headers_, "https://www.barrons.com/"));
+}
+
+TEST_F(ReferralHeadersTest, KeepsAllHeadersOfMatchingEntry) {
+  const ReferralHeaders::Headers* headers =
+      referral_headers_->GetMatchingHeaders(GURL("https://barrons.com/"));
+  ASSERT_TRUE(headers);
+  EXPECT_EQ(2u, headers->size());
+  EXPECT_EQ("test", headers->at("X-Invalid"));
+}
+
+TEST_F(ReferralHeadersTest, DoesNotMatchOtherDomains) {
+  EXPECT_EQ("", GetPartner(*referral_headers_, "https://www.google.com/"));
+  EXPECT_EQ("", GetPartner(*referral_headers_, "https://notbarrons.com/"));
+  EXPECT_EQ("", GetPartner(*referral_headers_, "https://barrons.com.evil/"));
+  EXPECT_EQ("", GetPartner(*referral_headers_, "https://xxlmag.com/"));
+  EXPECT_EQ("", GetPartner(*referral_headers_, "ftp://barrons.com/"));
+  EXPECT_EQ("", GetPartner(*referral_headers_, ""));
+}
+
+TEST(ReferralHeadersInvalidTest, IgnoresNonListValue) {
+  const ReferralHeaders referral_headers(base::Value("[]"));
+  EXPECT_TRUE(referral_headers.empty());
+  EXPECT_FALSE(
+      referral_headers.GetMatchingHeaders(GURL("https://barrons.com/")));
+}
+
+}  // namespace brave
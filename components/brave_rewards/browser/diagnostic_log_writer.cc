@@ -0,0 +1,196 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/diagnostic_log_writer.h"
+
+#include <algorithm>
+
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "brave/components/brave_rewards/browser/file_util.h"
+#include "brave/components/brave_rewards/browser/logging_util.h"
+
+namespace brave_rewards {
+
+DiagnosticLogEntry::DiagnosticLogEntry() = default;
+
+DiagnosticLogEntry::DiagnosticLogEntry(
+    const base::Time& time,
+    const std::string& file,
+    const int line,
+    const int verbose_level,
+    const std::string& message)
+    : time(time),
+      file(file),
+      line(line),
+      verbose_level(verbose_level),
+      message(message) {}
+
+DiagnosticLogEntry::DiagnosticLogEntry(
+    const DiagnosticLogEntry& entry) = default;
+
+DiagnosticLogEntry::DiagnosticLogEntry(
+    DiagnosticLogEntry&& entry) = default;
+
+DiagnosticLogEntry& DiagnosticLogEntry::operator=(
+    const DiagnosticLogEntry& entry) = default;
+
+DiagnosticLogEntry& DiagnosticLogEntry::operator=(
+    DiagnosticLogEntry&& entry) = default;
+
+DiagnosticLogEntry::~DiagnosticLogEntry() = default;
+
+DiagnosticLogWriter::DiagnosticLogWriter(
+    const base::FilePath& path,
+    const int64_t max_segment_size,
+    const int max_segments)
+    : path_(path),
+      max_segment_size_(max_segment_size),
+      max_segments_(max_segments) {
+  DCHECK_GT(max_segment_size_, 0);
+  DCHECK_GT(max_segments_, 0);
+}
+
+DiagnosticLogWriter::~DiagnosticLogWriter() = default;
+
+bool DiagnosticLogWriter::Write(
+    const DiagnosticLogEntries& entries) {
+  if (entries.empty()) {
+    return true;
+  }
+
+  if (!InitializeLog(&file_, path_)) {
+    return false;
+  }
+
+  std::string log_entries;
+  for (const auto& entry : entries) {
+    log_entries += FriendlyFormatLogEntry(entry.time, entry.file, entry.line,
+        entry.verbose_level, entry.message);
+  }
+
+  if (!WriteToLog(&file_, log_entries)) {
+    return false;
+  }
+
+  const int64_t length = file_.GetLength();
+  if (length == -1) {
+    return false;
+  }
+
+  if (length < max_segment_size_) {
+    return true;
+  }
+
+  return Rotate();
+}
+
+bool DiagnosticLogWriter::Read(
+    const int num_lines,
+    std::string* value) {
+  DCHECK(value);
+
+  *value = "";
+
+  int remaining_lines = num_lines;
+
+  for (int i = 0; i < max_segments_; i++) {
+    if (num_lines != -1 && remaining_lines <= 0) {
+      break;
+    }
+
+    std::string segment;
+    if (!ReadSegment(i, remaining_lines, &segment)) {
+      return false;
+    }
+
+    if (num_lines != -1) {
+      remaining_lines -= std::count(segment.begin(), segment.end(), '\n');
+    }
+
+    *value = segment + *value;
+  }
+
+  return true;
+}
+
+bool DiagnosticLogWriter::Delete() {
+  file_.Close();
+
+  bool success = true;
+  for (int i = 0; i < max_segments_; i++) {
+    if (!base::DeleteFile(GetSegmentPath(i))) {
+      success = false;
+    }
+  }
+
+  return success;
+}
+
+void DiagnosticLogWriter::Close() {
+  file_.Close();
+}
+
+std::string DiagnosticLogWriter::GetLastError() {
+  return GetLastFileError(&file_);
+}
+
+base::FilePath DiagnosticLogWriter::GetSegmentPath(
+    const int index) const {
+  if (index == 0) {
+    return path_;
+  }
+
+  return path_.AddExtensionASCII(base::NumberToString(index));
+}
+
+bool DiagnosticLogWriter::Rotate() {
+  file_.Close();
+
+  // Renaming is a metadata only operation, so rotating costs the same
+  // regardless of segment size
+  base::DeleteFile(GetSegmentPath(max_segments_ - 1));
+
+  for (int i = max_segments_ - 2; i >= 0; i--) {
+    const base::FilePath segment_path = GetSegmentPath(i);
+    if (!base::PathExists(segment_path)) {
+      continue;
+    }
+
+    if (!base::Move(segment_path, GetSegmentPath(i + 1))) {
+      return false;
+    }
+  }
+
+  return InitializeLog(&file_, path_);
+}
+
+bool DiagnosticLogWriter::ReadSegment(
+    const int index,
+    const int num_lines,
+    std::string* value) {
+  DCHECK(value);
+
+  if (index == 0 && file_.IsValid()) {
+    return TailFileAsString(&file_, num_lines, value);
+  }
+
+  const base::FilePath segment_path = GetSegmentPath(index);
+  if (!base::PathExists(segment_path)) {
+    *value = "";
+    return true;
+  }
+
+  base::File segment(segment_path,
+      base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!segment.IsValid()) {
+    return false;
+  }
+
+  return TailFileAsString(&segment, num_lines, value);
+}
+
+}  // namespace brave_rewards
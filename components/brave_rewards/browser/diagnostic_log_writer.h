@@ -0,0 +1,94 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_DIAGNOSTIC_LOG_WRITER_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_DIAGNOSTIC_LOG_WRITER_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/time/time.h"
+
+namespace brave_rewards {
+
+struct DiagnosticLogEntry {
+  DiagnosticLogEntry();
+  DiagnosticLogEntry(
+      const base::Time& time,
+      const std::string& file,
+      const int line,
+      const int verbose_level,
+      const std::string& message);
+  DiagnosticLogEntry(const DiagnosticLogEntry& entry);
+  DiagnosticLogEntry(DiagnosticLogEntry&& entry);
+  DiagnosticLogEntry& operator=(const DiagnosticLogEntry& entry);
+  DiagnosticLogEntry& operator=(DiagnosticLogEntry&& entry);
+  ~DiagnosticLogEntry();
+
+  base::Time time;
+  std::string file;
+  int line = 0;
+  int verbose_level = 0;
+  std::string message;
+};
+
+using DiagnosticLogEntries = std::vector<DiagnosticLogEntry>;
+
+// Writes diagnostic log entries to a ring of segment files. |path| is the
+// current segment, older segments are named |path|.1 to |path|.N-1 and the
+// oldest segment is dropped when the current segment is rotated. Must be used
+// on a sequence that allows blocking.
+class DiagnosticLogWriter {
+ public:
+  DiagnosticLogWriter(
+      const base::FilePath& path,
+      const int64_t max_segment_size,
+      const int max_segments);
+  ~DiagnosticLogWriter();
+
+  DiagnosticLogWriter(const DiagnosticLogWriter&) = delete;
+  DiagnosticLogWriter& operator=(const DiagnosticLogWriter&) = delete;
+
+  // Appends |entries| to the current segment with a single write
+  bool Write(
+      const DiagnosticLogEntries& entries);
+
+  // Returns the last |num_lines| lines across all segments, or all lines if
+  // |num_lines| is -1
+  bool Read(
+      const int num_lines,
+      std::string* value);
+
+  bool Delete();
+
+  void Close();
+
+  std::string GetLastError();
+
+  base::FilePath GetSegmentPath(
+      const int index) const;
+
+ private:
+  bool Rotate();
+
+  bool ReadSegment(
+      const int index,
+      const int num_lines,
+      std::string* value);
+
+  const base::FilePath path_;
+  const int64_t max_segment_size_;
+  const int max_segments_;
+
+  base::File file_;
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_DIAGNOSTIC_LOG_WRITER_H_
@@ -0,0 +1,138 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/diagnostic_log_writer.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=DiagnosticLogWriterTest.*
+
+namespace brave_rewards {
+
+namespace {
+
+const int64_t kMaxSegmentSize = 1024;
+const int kMaxSegments = 3;
+
+DiagnosticLogEntries BuildEntries(
+    const int first_line,
+    const int count) {
+  DiagnosticLogEntries entries;
+  for (int i = 0; i < count; i++) {
+    const int line = first_line + i;
+    entries.emplace_back(base::Time::Now(), "file.cc", line, 1,
+        "message " + base::NumberToString(line));
+  }
+
+  return entries;
+}
+
+int CountLines(
+    const std::string& value) {
+  return std::count(value.begin(), value.end(), '\n');
+}
+
+}  // namespace
+
+class DiagnosticLogWriterTest : public testing::Test {
+ public:
+  DiagnosticLogWriterTest() = default;
+  ~DiagnosticLogWriterTest() override = default;
+
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    writer_ = std::make_unique<DiagnosticLogWriter>(
+        temp_dir_.GetPath().AppendASCII("Rewards.log"), kMaxSegmentSize,
+            kMaxSegments);
+  }
+
+  void TearDown() override {
+    writer_.reset();
+  }
+
+  DiagnosticLogWriter* writer() { return writer_.get(); }
+
+ private:
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<DiagnosticLogWriter> writer_;
+};
+
+TEST_F(DiagnosticLogWriterTest, WriteBatch) {
+  // Arrange
+
+  // Act
+  ASSERT_TRUE(writer()->Write(BuildEntries(1, 5)));
+
+  // Assert
+  std::string value;
+  ASSERT_TRUE(writer()->Read(-1, &value));
+  EXPECT_EQ(5, CountLines(value));
+  EXPECT_NE(std::string::npos, value.find("message 1\n"));
+  EXPECT_NE(std::string::npos, value.find("message 5\n"));
+}
+
+TEST_F(DiagnosticLogWriterTest, RotateSegments) {
+  // Arrange
+
+  // Act
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(writer()->Write(BuildEntries(i * 10, 10)));
+  }
+
+  // Assert
+  for (int i = 0; i < kMaxSegments; i++) {
+    EXPECT_TRUE(base::PathExists(writer()->GetSegmentPath(i)));
+  }
+
+  EXPECT_FALSE(base::PathExists(writer()->GetSegmentPath(kMaxSegments)));
+
+  for (int i = 1; i < kMaxSegments; i++) {
+    int64_t size = 0;
+    ASSERT_TRUE(base::GetFileSize(writer()->GetSegmentPath(i), &size));
+    EXPECT_GE(size, kMaxSegmentSize);
+  }
+}
+
+TEST_F(DiagnosticLogWriterTest, ReadAcrossSegments) {
+  // Arrange
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(writer()->Write(BuildEntries(i * 10, 10)));
+  }
+
+  // Act
+  std::string value;
+  ASSERT_TRUE(writer()->Read(40, &value));
+
+  // Assert
+  EXPECT_EQ(40, CountLines(value));
+  EXPECT_NE(std::string::npos, value.find("message 999\n"));
+  EXPECT_NE(std::string::npos, value.find("message 960\n"));
+  EXPECT_EQ(std::string::npos, value.find("message 959\n"));
+}
+
+TEST_F(DiagnosticLogWriterTest, Delete) {
+  // Arrange
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(writer()->Write(BuildEntries(i * 10, 10)));
+  }
+
+  // Act
+  ASSERT_TRUE(writer()->Delete());
+
+  // Assert
+  for (int i = 0; i < kMaxSegments; i++) {
+    EXPECT_FALSE(base::PathExists(writer()->GetSegmentPath(i)));
+  }
+}
+
+}  // namespace brave_rewards
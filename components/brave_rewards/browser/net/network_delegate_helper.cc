@@ -23,6 +23,9 @@ namespace brave_rewards {
 
 namespace {
 
+// Media pings are small; anything bigger is an upload we don't care about.
+constexpr size_t kMaxPostDataSize = 64 * 1024;
+
 content::WebContents* GetWebContents(
     int render_process_id,
     int render_frame_id,
@@ -77,8 +80,9 @@ int OnBeforeURLRequest(
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
   if (IsMediaLink(ctx->request_url, ctx->tab_origin, ctx->referrer)) {
-    if (!ctx->upload_data.empty()) {
-      DispatchOnUI(ctx->upload_data,
+    const std::string upload_data = ctx->GetUploadData(kMaxPostDataSize);
+    if (!upload_data.empty()) {
+      DispatchOnUI(upload_data,
                    ctx->request_url,
                    ctx->tab_url,
                    ctx->referrer.spec(),
@@ -32,6 +32,7 @@
 #include "base/task_runner_util.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "bat/ads/pref_names.h"
 #include "bat/ledger/global_constants.h"
 #include "bat/ledger/ledger_database.h"
@@ -41,9 +42,7 @@
 #include "brave/components/brave_ads/browser/ads_service_factory.h"
 #include "brave/components/brave_ads/browser/buildflags/buildflags.h"
 #include "brave/components/brave_rewards/browser/android_util.h"
-#include "brave/components/brave_rewards/browser/file_util.h"
 #include "brave/components/brave_rewards/browser/logging.h"
-#include "brave/components/brave_rewards/browser/logging_util.h"
 #include "brave/components/brave_rewards/browser/rewards_notification_service.h"
 #include "brave/components/brave_rewards/browser/rewards_notification_service_impl.h"
 #include "brave/components/brave_rewards/browser/rewards_p3a.h"
@@ -96,8 +95,10 @@ static const unsigned int kRetriesCountOnNetworkChange = 1;
 namespace {
 
 const int kDiagnosticLogMaxVerboseLevel = 6;
-const int kTailDiagnosticLogToNumLines = 20000;
-const int kDiagnosticLogMaxFileSize = 10 * (1024 * 1024);
+const int64_t kDiagnosticLogMaxSegmentSize = 2 * (1024 * 1024);
+const int kDiagnosticLogMaxSegments = 5;
+const size_t kDiagnosticLogMaxPendingEntries = 500;
+const int kDiagnosticLogFlushIntervalInSeconds = 2;
 const char pref_prefix[] = "brave.rewards";
 
 std::string URLMethodToRequestType(ledger::type::UrlMethod method) {
@@ -297,12 +298,17 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
 #if BUILDFLAG(ENABLE_GREASELION)
       greaselion_service_(greaselion_service),
 #endif
-      bat_ledger_client_receiver_(new bat_ledger::LedgerClientMojoBridge(this)),
+      bat_ledger_client_receiver_(new bat_ledger::LedgerClientMojoBridge(
+          this,
+          base::BindRepeating(&RewardsServiceImpl::LogWithTime,
+                              base::Unretained(this)))),
       file_task_runner_(base::CreateSequencedTaskRunner(
           {base::ThreadPool(), base::MayBlock(),
            base::TaskPriority::USER_VISIBLE,
            base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
       diagnostic_log_path_(profile_->GetPath().Append(kDiagnosticLogPath)),
+      diagnostic_log_(diagnostic_log_path_, kDiagnosticLogMaxSegmentSize,
+          kDiagnosticLogMaxSegments),
       ledger_state_path_(profile_->GetPath().Append(kLedger_state)),
       publisher_state_path_(profile_->GetPath().Append(kPublisher_state)),
       publisher_info_db_path_(profile->GetPath().Append(kPublisher_info_db)),
@@ -807,6 +813,8 @@ void RewardsServiceImpl::Shutdown() {
   }
   url_loaders_.clear();
 
+  FlushDiagnosticLog();
+
   bat_ledger_.reset();
   RewardsService::Shutdown();
 }
@@ -1385,17 +1393,15 @@ void RewardsServiceImpl::OnStopLedgerForCompleteReset(
 
 bool RewardsServiceImpl::ResetOnFilesTaskRunner() {
   // Close any open files before deleting them (required on Windows)
-  diagnostic_log_.Close();
+  bool res = diagnostic_log_.Delete();
 
   const std::vector<base::FilePath> paths = {
     ledger_state_path_,
     publisher_state_path_,
     publisher_info_db_path_,
-    diagnostic_log_path_,
     publisher_list_path_,
   };
 
-  bool res = true;
   for (size_t i = 0; i < paths.size(); i++) {
     if (!base::DeletePathRecursively(paths[i])) {
       res = false;
@@ -2242,33 +2248,16 @@ void RewardsServiceImpl::ShowNotificationTipsPaid(bool ac_enabled) {
       "rewards_notification_tips_processed");
 }
 
-bool RewardsServiceImpl::MaybeTailDiagnosticLog(
-    const int num_lines) {
-  if (!diagnostic_log_.IsValid()) {
-    return false;
-  }
-
-  static bool first_run = true;
-
-  const int64_t length = diagnostic_log_.GetLength();
-  if (length == -1) {
-    return false;
-  }
-
-  if (!first_run && length <= kDiagnosticLogMaxFileSize) {
-    return true;
-  }
-
-  first_run = false;
-
-  if (!TailFile(&diagnostic_log_, num_lines)) {
-    return false;
-  }
-
-  return true;
+void RewardsServiceImpl::DiagnosticLog(
+    const std::string& file,
+    const int line,
+    const int verbose_level,
+    const std::string& message) {
+  DiagnosticLogWithTime(base::Time::Now(), file, line, verbose_level, message);
 }
 
-void RewardsServiceImpl::DiagnosticLog(
+void RewardsServiceImpl::DiagnosticLogWithTime(
+    const base::Time& time,
     const std::string& file,
     const int line,
     const int verbose_level,
@@ -2285,47 +2274,55 @@ void RewardsServiceImpl::DiagnosticLog(
     return;
   }
 
-  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::BindOnce(&RewardsServiceImpl::WriteToDiagnosticLogOnFileTaskRunner,
-          base::Unretained(this),
-          diagnostic_log_path_,
-          kTailDiagnosticLogToNumLines,
-          file,
-          line,
-          verbose_level,
-          message),
-      base::BindOnce(&RewardsServiceImpl::OnWriteToLogOnFileTaskRunner,
-          AsWeakPtr()));
-}
+  pending_diagnostic_log_entries_.emplace_back(time, file, line,
+      verbose_level, message);
 
-bool RewardsServiceImpl::WriteToDiagnosticLogOnFileTaskRunner(
-    const base::FilePath& log_path,
-    const int num_lines,
-    const std::string& file,
-    const int line,
-    const int verbose_level,
-    const std::string& message) {
-  if (!InitializeLog(&diagnostic_log_, log_path)) {
-    VLOG(0) << "Failed to initialize diagnostic log: "
-        << GetLastFileError(&diagnostic_log_);
+  // Errors are written straight away so they are not lost if the browser
+  // crashes before the next flush
+  if (verbose_level == 0 || pending_diagnostic_log_entries_.size() >=
+      kDiagnosticLogMaxPendingEntries) {
+    FlushDiagnosticLog();
+    return;
+  }
 
-    return false;
+  if (!diagnostic_log_flush_timer_) {
+    diagnostic_log_flush_timer_ = std::make_unique<base::OneShotTimer>();
   }
 
-  const base::Time time = base::Time::Now();
+  if (diagnostic_log_flush_timer_->IsRunning()) {
+    return;
+  }
 
-  const std::string log_entry =
-      FriendlyFormatLogEntry(time, file, line, verbose_level, message);
+  diagnostic_log_flush_timer_->Start(FROM_HERE,
+      base::TimeDelta::FromSeconds(kDiagnosticLogFlushIntervalInSeconds),
+      this, &RewardsServiceImpl::FlushDiagnosticLog);
+}
 
-  if (!WriteToLog(&diagnostic_log_, log_entry)) {
-    VLOG(0) << "Failed to write to diagnostic log: "
-        << GetLastFileError(&diagnostic_log_);
+void RewardsServiceImpl::FlushDiagnosticLog() {
+  if (diagnostic_log_flush_timer_) {
+    diagnostic_log_flush_timer_->Stop();
+  }
 
-    return false;
+  if (pending_diagnostic_log_entries_.empty()) {
+    return;
   }
 
-  if (!MaybeTailDiagnosticLog(num_lines)) {
-    VLOG(0) << "Failed to vacuum diagnostic log";
+  DiagnosticLogEntries entries;
+  entries.swap(pending_diagnostic_log_entries_);
+
+  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&RewardsServiceImpl::WriteToDiagnosticLogOnFileTaskRunner,
+          base::Unretained(this),
+          std::move(entries)),
+      base::BindOnce(&RewardsServiceImpl::OnWriteToLogOnFileTaskRunner,
+          AsWeakPtr()));
+}
+
+bool RewardsServiceImpl::WriteToDiagnosticLogOnFileTaskRunner(
+    const DiagnosticLogEntries& entries) {
+  if (!diagnostic_log_.Write(entries)) {
+    VLOG(0) << "Failed to write to diagnostic log: "
+        << diagnostic_log_.GetLastError();
 
     return false;
   }
@@ -2341,6 +2338,8 @@ void RewardsServiceImpl::OnWriteToLogOnFileTaskRunner(
 void RewardsServiceImpl::LoadDiagnosticLog(
       const int num_lines,
       LoadDiagnosticLogCallback callback) {
+  FlushDiagnosticLog();
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&RewardsServiceImpl::LoadDiagnosticLogOnFileTaskRunner,
           base::Unretained(this),
@@ -2359,9 +2358,9 @@ std::string RewardsServiceImpl::LoadDiagnosticLogOnFileTaskRunner(
   }
 
   std::string value;
-  if (!TailFileAsString(&diagnostic_log_, num_lines, &value)) {
+  if (!diagnostic_log_.Read(num_lines, &value)) {
     return base::StringPrintf("ERROR: %s",
-        GetLastFileError(&diagnostic_log_).c_str());
+        diagnostic_log_.GetLastError().c_str());
   }
 
   return value;
@@ -2375,6 +2374,8 @@ void RewardsServiceImpl::OnLoadDiagnosticLogOnFileTaskRunner(
 
 void RewardsServiceImpl::ClearDiagnosticLog(
     ClearDiagnosticLogCallback callback) {
+  pending_diagnostic_log_entries_.clear();
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&RewardsServiceImpl::ClearDiagnosticLogOnFileTaskRunner,
           base::Unretained(this),
@@ -2386,13 +2387,7 @@ void RewardsServiceImpl::ClearDiagnosticLog(
 
 bool RewardsServiceImpl::ClearDiagnosticLogOnFileTaskRunner(
     const base::FilePath& path) {
-  if (!base::PathExists(path)) {
-    return true;
-  }
-
-  diagnostic_log_.Close();
-
-  return base::DeleteFile(path);
+  return diagnostic_log_.Delete();
 }
 
 void RewardsServiceImpl::OnClearDiagnosticLogOnFileTaskRunner(
@@ -2408,11 +2403,22 @@ void RewardsServiceImpl::Log(
     const std::string& message) {
   DCHECK(file);
 
-  DiagnosticLog(file, line, verbose_level, message);
+  LogWithTime(base::Time::Now(), file, line, verbose_level, message);
+}
+
+void RewardsServiceImpl::LogWithTime(
+    const base::Time& time,
+    const std::string& file,
+    const int line,
+    const int verbose_level,
+    const std::string& message) {
+  DiagnosticLogWithTime(time, file, line, verbose_level, message);
 
-  const int vlog_level = ::logging::GetVlogLevelHelper(file, strlen(file));
+  const int vlog_level =
+      ::logging::GetVlogLevelHelper(file.c_str(), file.length());
   if (verbose_level <= vlog_level) {
-    ::logging::LogMessage(file, line, -verbose_level).stream() << message;
+    ::logging::LogMessage(file.c_str(), line, -verbose_level).stream()
+        << message;
   }
 }
 
@@ -3330,6 +3336,7 @@ void RewardsServiceImpl::ClearAllNotifications() {
 
 void RewardsServiceImpl::CompleteReset(SuccessCallback callback) {
   resetting_rewards_ = true;
+  pending_diagnostic_log_entries_.clear();
 
   auto* ads_service = brave_ads::AdsServiceFactory::GetForProfile(profile_);
   if (ads_service) {
@@ -3376,7 +3383,8 @@ void RewardsServiceImpl::WalletDisconnected(const std::string& wallet_type) {
 }
 
 void RewardsServiceImpl::DeleteLog(ledger::ResultCallback callback) {
-  diagnostic_log_.Close();
+  pending_diagnostic_log_entries_.clear();
+
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
       FROM_HERE,
@@ -3390,7 +3398,7 @@ void RewardsServiceImpl::DeleteLog(ledger::ResultCallback callback) {
 }
 
 bool RewardsServiceImpl::DeleteLogTaskRunner() {
-  return base::DeleteFile(diagnostic_log_path_);
+  return diagnostic_log_.Delete();
 }
 
 void RewardsServiceImpl::OnDeleteLog(
@@ -23,6 +23,7 @@
 #include "base/values.h"
 #include "bat/ledger/ledger.h"
 #include "bat/ledger/ledger_client.h"
+#include "brave/components/brave_rewards/browser/diagnostic_log_writer.h"
 #include "brave/components/brave_rewards/browser/rewards_service.h"
 #include "brave/components/brave_rewards/browser/rewards_service_private_observer.h"
 #include "brave/components/greaselion/browser/buildflags/buildflags.h"
@@ -577,23 +578,24 @@ class RewardsServiceImpl : public RewardsService,
       SavePublisherInfoCallback callback,
       const ledger::type::Result result);
 
-  bool MaybeTailDiagnosticLog(
-      const int num_lines);
-
   void DiagnosticLog(
       const std::string& file,
       const int line,
       const int verbose_level,
       const std::string& message) override;
 
-  bool WriteToDiagnosticLogOnFileTaskRunner(
-      const base::FilePath& log_path,
-      const int num_lines,
+  void DiagnosticLogWithTime(
+      const base::Time& time,
       const std::string& file,
       const int line,
       const int verbose_level,
       const std::string& message);
 
+  void FlushDiagnosticLog();
+
+  bool WriteToDiagnosticLogOnFileTaskRunner(
+      const DiagnosticLogEntries& entries);
+
   void OnWriteToLogOnFileTaskRunner(
     const bool success);
 
@@ -626,6 +628,14 @@ class RewardsServiceImpl : public RewardsService,
       const int verbose_level,
       const std::string& message) override;
 
+  // Logs an entry which was logged at |time| in the utility process
+  void LogWithTime(
+      const base::Time& time,
+      const std::string& file,
+      const int line,
+      const int verbose_level,
+      const std::string& message);
+
   void SetBooleanState(const std::string& name, bool value) override;
   bool GetBooleanState(const std::string& name) const override;
   void SetIntegerState(const std::string& name, int value) override;
@@ -784,7 +794,9 @@ class RewardsServiceImpl : public RewardsService,
   mojo::Remote<bat_ledger::mojom::BatLedgerService> bat_ledger_service_;
   const scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
   const base::FilePath diagnostic_log_path_;
-  base::File diagnostic_log_;
+  DiagnosticLogWriter diagnostic_log_;
+  DiagnosticLogEntries pending_diagnostic_log_entries_;
+  std::unique_ptr<base::OneShotTimer> diagnostic_log_flush_timer_;
   const base::FilePath ledger_state_path_;
   const base::FilePath publisher_state_path_;
   const base::FilePath publisher_info_db_path_;
@@ -162,16 +162,21 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
   }
 }
 
-void AdBlockBaseService::AddResources(const std::string& resources) {
+void AdBlockBaseService::AddResources(
+    scoped_refptr<const base::RefCountedString> resources) {
   if (BrowserThread::CurrentlyOn(BrowserThread::UI)) {
     GetTaskRunner()->PostTask(
-        FROM_HERE, base::BindOnce(&AdBlockBaseService::AddResources,
-                                  base::Unretained(this), resources));
+        FROM_HERE,
+        base::BindOnce(&AdBlockBaseService::AddResources,
+                       base::Unretained(this), std::move(resources)));
     return;
   }
 
-  ad_block_client_->addResources(resources);
-  resources_ = resources;
+  if (resources_ == resources) {
+    return;
+  }
+  resources_ = std::move(resources);
+  AddKnownResourcesToAdBlockInstance();
 }
 
 bool AdBlockBaseService::TagExists(const std::string& tag) {
@@ -231,7 +236,9 @@ void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
 }
 
 void AdBlockBaseService::AddKnownResourcesToAdBlockInstance() {
-  ad_block_client_->addResources(resources_);
+  if (resources_) {
+    ad_block_client_->addResources(resources_->data());
+  }
 }
 
 bool AdBlockBaseService::Init() {
@@ -246,7 +253,8 @@ void AdBlockBaseService::ResetForTest(const std::string& rules,
   ad_block_client_.reset(new adblock::Engine(rules));
   AddKnownTagsToAdBlockInstance();
   if (!resources.empty()) {
-    resources_ = resources;
+    std::string resources_copy = resources;
+    resources_ = base::RefCountedString::TakeString(&resources_copy);
   }
   AddKnownResourcesToAdBlockInstance();
 }
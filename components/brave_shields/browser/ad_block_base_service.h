@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/values.h"
@@ -47,7 +48,10 @@ class AdBlockBaseService : public BaseBraveShieldsService {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* mock_data_url) override;
-  void AddResources(const std::string& resources);
+  // |resources| is the resources.json contents shared by every engine. Each
+  // version is handed to the engine once, and again only when the engine is
+  // reloaded.
+  void AddResources(scoped_refptr<const base::RefCountedString> resources);
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
 
@@ -66,17 +70,18 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void AddKnownTagsToAdBlockInstance();
   void AddKnownResourcesToAdBlockInstance();
   void ResetForTest(const std::string& rules, const std::string& resources);
+  // Replaces the engine and re-applies the known tags and resources to it.
+  void UpdateAdBlockClient(
+      std::unique_ptr<adblock::Engine> ad_block_client);
 
   std::unique_ptr<adblock::Engine> ad_block_client_;
 
  private:
-  void UpdateAdBlockClient(
-      std::unique_ptr<adblock::Engine> ad_block_client);
   void OnGetDATFileData(GetDATFileDataResult result);
   void OnPreferenceChanges(const std::string& pref_name);
 
   std::vector<std::string> tags_;
-  std::string resources_;
+  scoped_refptr<const base::RefCountedString> resources_;
   base::WeakPtrFactory<AdBlockBaseService> weak_factory_;
   DISALLOW_COPY_AND_ASSIGN(AdBlockBaseService);
 };
@@ -5,7 +5,12 @@
 
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
 #include "base/logging.h"
+#include "base/task/post_task.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
@@ -18,7 +23,12 @@ using brave_component_updater::BraveComponent;
 namespace brave_shields {
 
 AdBlockCustomFiltersService::AdBlockCustomFiltersService(
-    BraveComponent::Delegate* delegate) : AdBlockBaseService(delegate) {
+    BraveComponent::Delegate* delegate)
+    : AdBlockBaseService(delegate),
+      compile_task_runner_(base::CreateSequencedTaskRunner(
+          {base::ThreadPool(), base::MayBlock(),
+           base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {
 }
 
 AdBlockCustomFiltersService::~AdBlockCustomFiltersService() {
@@ -44,19 +54,31 @@ bool AdBlockCustomFiltersService::UpdateCustomFilters(
     return false;
   local_state->SetString(kAdBlockCustomFilters, custom_filters);
 
-  GetTaskRunner()->PostTask(
+  // The initial engine is empty, and saving the same filters again does not
+  // need a new one.
+  if (custom_filters == compiled_custom_filters_)
+    return true;
+  compiled_custom_filters_ = custom_filters;
+
+  // Compiles run in order on their own sequence, so the swaps they post to
+  // the shields task runner land in order and the latest filters win.
+  compile_task_runner_->PostTask(
       FROM_HERE,
-      base::BindOnce(
-          &AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner,
-          base::Unretained(this), custom_filters));
+      base::BindOnce(&AdBlockCustomFiltersService::CompileCustomFilters,
+                     base::Unretained(this), custom_filters));
 
   return true;
 }
 
-void AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner(
+void AdBlockCustomFiltersService::CompileCustomFilters(
     const std::string& custom_filters) {
-  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  ad_block_client_.reset(new adblock::Engine(custom_filters.c_str()));
+  DCHECK(compile_task_runner_->RunsTasksInCurrentSequence());
+  auto ad_block_client =
+      std::make_unique<adblock::Engine>(custom_filters.c_str());
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&AdBlockCustomFiltersService::UpdateAdBlockClient,
+                     base::Unretained(this), std::move(ad_block_client)));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -9,6 +9,8 @@
 #include <memory>
 #include <string>
 
+#include "base/memory/scoped_refptr.h"
+#include "base/sequenced_task_runner.h"
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 
 class AdBlockServiceTest;
@@ -32,7 +34,14 @@ class AdBlockCustomFiltersService : public AdBlockBaseService {
 
  private:
   friend class ::AdBlockServiceTest;
-  void UpdateCustomFiltersOnFileTaskRunner(const std::string& custom_filters);
+  void CompileCustomFilters(const std::string& custom_filters);
+
+  // Filter text of the most recently requested engine, used to skip
+  // recompiling when the filters are saved unchanged. UI thread only.
+  std::string compiled_custom_filters_;
+  // Engines are built here so that request matching on the shields task
+  // runner keeps using the previous engine while the new one compiles.
+  scoped_refptr<base::SequencedTaskRunner> compile_task_runner_;
 
   DISALLOW_COPY_AND_ASSIGN(AdBlockCustomFiltersService);
 };
@@ -39,7 +39,6 @@ class AdBlockRegionalService : public AdBlockBaseService {
   void OnComponentReady(const std::string& component_id,
                         const base::FilePath& install_dir,
                         const std::string& manifest) override;
-  void OnResourcesFileDataReady(const std::string& resources);
 
  private:
   friend class ::AdBlockServiceTest;
@@ -55,7 +54,6 @@ class AdBlockRegionalService : public AdBlockBaseService {
   std::string component_id_;
   std::string base64_public_key_;
 
-  base::WeakPtrFactory<AdBlockRegionalService> weak_factory_{this};
   DISALLOW_COPY_AND_ASSIGN(AdBlockRegionalService);
 };
 
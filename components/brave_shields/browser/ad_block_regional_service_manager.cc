@@ -86,6 +86,8 @@ void AdBlockRegionalServiceManager::StartRegionalServices() {
       if (catalog_entry != regional_catalog_.end()) {
         auto regional_service = AdBlockRegionalServiceFactory(
             *catalog_entry, delegate_);
+        if (resources_)
+          regional_service->AddResources(resources_);
         regional_service->Start();
         regional_services_.insert(
             std::make_pair(uuid, std::move(regional_service)));
@@ -152,10 +154,11 @@ void AdBlockRegionalServiceManager::EnableTag(const std::string& tag,
 }
 
 void AdBlockRegionalServiceManager::AddResources(
-    const std::string& resources) {
+    scoped_refptr<const base::RefCountedString> resources) {
   base::AutoLock lock(regional_services_lock_);
+  resources_ = std::move(resources);
   for (const auto& regional_service : regional_services_) {
-    regional_service.second->AddResources(resources);
+    regional_service.second->AddResources(resources_);
   }
 }
 
@@ -174,6 +177,8 @@ void AdBlockRegionalServiceManager::EnableFilterList(
       DCHECK(it == regional_services_.end());
       auto regional_service = AdBlockRegionalServiceFactory(
           *catalog_entry, delegate_);
+      if (resources_)
+        regional_service->AddResources(resources_);
       regional_service->Start();
       regional_services_.insert(
           std::make_pair(uuid, std::move(regional_service)));
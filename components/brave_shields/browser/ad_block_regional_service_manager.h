@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/macros.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/optional.h"
 #include "base/synchronization/lock.h"
@@ -55,7 +56,8 @@ class AdBlockRegionalServiceManager {
                           bool* did_match_important,
                           std::string* mock_data_url);
   void EnableTag(const std::string& tag, bool enabled);
-  void AddResources(const std::string& resources);
+  // Also given to regional services started later.
+  void AddResources(scoped_refptr<const base::RefCountedString> resources);
   void EnableFilterList(const std::string& uuid, bool enabled);
 
   base::Optional<base::Value> UrlCosmeticResources(
@@ -67,6 +69,7 @@ class AdBlockRegionalServiceManager {
 
  private:
   friend class ::AdBlockServiceTest;
+  friend class BraveShieldsPerfTest;
   bool Init();
   void StartRegionalServices();
   void UpdateFilterListPrefs(const std::string& uuid, bool enabled);
@@ -76,6 +79,7 @@ class AdBlockRegionalServiceManager {
   base::Lock regional_services_lock_;
   std::map<std::string, std::unique_ptr<AdBlockRegionalService>>
       regional_services_;
+  scoped_refptr<const base::RefCountedString> resources_;
 
   std::vector<adblock::FilterList> regional_catalog_;
 
@@ -225,9 +225,14 @@ void AdBlockService::OnComponentReady(const std::string& component_id,
                      weak_factory_.GetWeakPtr()));
 }
 
-void AdBlockService::OnResourcesFileDataReady(const std::string& resources) {
-  AddResources(resources);
-  custom_filters_service()->AddResources(resources);
+void AdBlockService::OnResourcesFileDataReady(std::string resources) {
+  // Read once here and shared with the custom filters and regional engines,
+  // which all use the same resources.
+  scoped_refptr<const base::RefCountedString> shared_resources =
+      base::RefCountedString::TakeString(&resources);
+  AddResources(shared_resources);
+  custom_filters_service()->AddResources(shared_resources);
+  regional_service_manager()->AddResources(shared_resources);
 }
 
 void AdBlockService::OnRegionalCatalogFileDataReady(
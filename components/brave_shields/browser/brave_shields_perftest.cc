@@ -0,0 +1,485 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_reader.h"
+#include "base/path_service.h"
+#include "base/process/process_metrics.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "brave/common/brave_paths.h"
+#include "brave/common/pref_names.h"
+#include "brave/components/brave_component_updater/browser/brave_component.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
+#include "brave/components/brave_shields/browser/ad_block_regional_service.h"
+#include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
+#include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/https_everywhere_service.h"
+#include "brave/vendor/adblock_rust_ffi/src/wrapper.h"
+#include "chrome/test/base/testing_browser_process.h"
+#include "components/prefs/scoped_user_pref_update.h"
+#include "components/prefs/testing_pref_service.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+
+// Replays test/data/shields-perf/request_corpus.json through the shields
+// request path and reports per-stage latency percentiles and the memory held
+// by the loaded engines.
+// npm run test -- brave_shields_perftests
+
+using brave_component_updater::BraveComponent;
+
+namespace brave_shields {
+
+namespace {
+
+constexpr char kPerfDataDir[] = "shields-perf";
+constexpr char kCorpusFile[] = "request_corpus.json";
+constexpr char kFilterListFile[] = "filters.txt";
+constexpr char kStoryName[] = "request_corpus";
+
+// Each regional list is a copy of the regional DAT fixture registered under
+// its own UUID, so that the manager fans out over several engines.
+constexpr char kRegionalFixtureUUID[] = "9852EFC4-99E4-4F2D-A915-9C3196C7A1DE";
+constexpr size_t kRegionalListCount = 4;
+
+// Blocked by the filter list and by the regional fixture respectively, so
+// that an engine whose list failed to load is caught before it is timed.
+constexpr char kDefaultBlockedURL[] = "https://adnet-example.com/ad.js";
+constexpr char kRegionalBlockedURL[] = "https://example.fr/ad_fr.png";
+
+// Number of times the corpus is replayed. The first replay is not recorded so
+// that lazily built engine state doesn't skew the percentiles.
+constexpr int kIterations = 20;
+
+struct CorpusRequest {
+  GURL page;
+  GURL url;
+  blink::mojom::ResourceType type;
+};
+
+struct CorpusPage {
+  GURL url;
+  std::vector<std::string> classes;
+  std::vector<std::string> ids;
+};
+
+bool ResourceTypeFromString(const std::string& type,
+                            blink::mojom::ResourceType* resource_type) {
+  static constexpr struct {
+    const char* name;
+    blink::mojom::ResourceType type;
+  } kTypes[] = {
+      {"main_frame", blink::mojom::ResourceType::kMainFrame},
+      {"sub_frame", blink::mojom::ResourceType::kSubFrame},
+      {"stylesheet", blink::mojom::ResourceType::kStylesheet},
+      {"script", blink::mojom::ResourceType::kScript},
+      {"image", blink::mojom::ResourceType::kImage},
+      {"font", blink::mojom::ResourceType::kFontResource},
+      {"media", blink::mojom::ResourceType::kMedia},
+      {"xhr", blink::mojom::ResourceType::kXhr},
+      {"other", blink::mojom::ResourceType::kSubResource},
+  };
+  for (const auto& entry : kTypes) {
+    if (type == entry.name) {
+      *resource_type = entry.type;
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<std::string> StringsFromList(const base::Value* list) {
+  std::vector<std::string> strings;
+  if (!list || !list->is_list())
+    return strings;
+  for (const auto& value : list->GetList()) {
+    if (value.is_string())
+      strings.push_back(value.GetString());
+  }
+  return strings;
+}
+
+size_t GetMallocUsage() {
+  return base::ProcessMetrics::CreateCurrentProcessMetrics()->GetMallocUsage();
+}
+
+// Hands each registered component the install directory set up for it, the
+// way the component updater does once a component is on disk. Everything runs
+// on the test's main sequence.
+class PerfComponentDelegate : public BraveComponent::Delegate {
+ public:
+  PerfComponentDelegate() = default;
+  ~PerfComponentDelegate() override = default;
+
+  void SetInstallDir(const std::string& component_name,
+                     const base::FilePath& install_dir) {
+    install_dirs_[component_name] = install_dir;
+  }
+
+  // BraveComponent::Delegate:
+  void Register(const std::string& component_name,
+                const std::string& component_base64_public_key,
+                base::OnceClosure registered_callback,
+                BraveComponent::ReadyCallback ready_callback) override {
+    std::move(registered_callback).Run();
+    auto it = install_dirs_.find(component_name);
+    if (it == install_dirs_.end())
+      return;
+    GetTaskRunner()->PostTask(
+        FROM_HERE, base::BindOnce(ready_callback, it->second, std::string()));
+  }
+  bool Unregister(const std::string& component_id) override { return true; }
+  void OnDemandUpdate(const std::string& component_id) override {}
+  void AddObserver(BraveComponent::ComponentObserver* observer) override {}
+  void RemoveObserver(BraveComponent::ComponentObserver* observer) override {}
+  scoped_refptr<base::SequencedTaskRunner> GetTaskRunner() override {
+    return base::SequencedTaskRunnerHandle::Get();
+  }
+
+ private:
+  std::map<std::string, base::FilePath> install_dirs_;
+
+  DISALLOW_COPY_AND_ASSIGN(PerfComponentDelegate);
+};
+
+// The default engine, built from the checked-in filter list so that it has a
+// realistic mix of network and cosmetic rules.
+class PerfAdBlockService : public AdBlockBaseService {
+ public:
+  explicit PerfAdBlockService(BraveComponent::Delegate* delegate)
+      : AdBlockBaseService(delegate) {}
+  ~PerfAdBlockService() override = default;
+
+  void LoadRules(const std::string& rules) { ResetForTest(rules, ""); }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(PerfAdBlockService);
+};
+
+// Collects the latency samples of one stage of the request path.
+class StageTimings {
+ public:
+  explicit StageTimings(const std::string& stage) : stage_(stage) {}
+
+  void Add(base::TimeDelta sample) { samples_.push_back(sample); }
+
+  void Report() {
+    ASSERT_FALSE(samples_.empty()) << stage_;
+    std::sort(samples_.begin(), samples_.end());
+
+    perf_test::PerfResultReporter reporter(stage_, kStoryName);
+    reporter.RegisterImportantMetric(".p50", "us");
+    reporter.RegisterImportantMetric(".p90", "us");
+    reporter.RegisterImportantMetric(".p99", "us");
+    reporter.RegisterFyiMetric(".max", "us");
+    reporter.RegisterFyiMetric(".samples", "count");
+    reporter.AddResult(".p50", Percentile(50));
+    reporter.AddResult(".p90", Percentile(90));
+    reporter.AddResult(".p99", Percentile(99));
+    reporter.AddResult(".max", samples_.back());
+    reporter.AddResult(".samples", samples_.size());
+  }
+
+ private:
+  base::TimeDelta Percentile(size_t percentile) const {
+    return samples_[(samples_.size() - 1) * percentile / 100];
+  }
+
+  const std::string stage_;
+  std::vector<base::TimeDelta> samples_;
+};
+
+}  // namespace
+
+class BraveShieldsPerfTest : public testing::Test {
+ public:
+  BraveShieldsPerfTest() = default;
+  ~BraveShieldsPerfTest() override = default;
+
+  void SetUp() override {
+    RegisterPrefsForAdBlockService(local_state_.registry());
+    TestingBrowserProcess::GetGlobal()->SetLocalState(&local_state_);
+
+    ASSERT_TRUE(base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir_));
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    ASSERT_NO_FATAL_FAILURE(LoadCorpus());
+  }
+
+  void TearDown() override {
+    https_everywhere_service_.reset();
+    regional_service_manager_.reset();
+    ad_block_service_.reset();
+    task_environment_.RunUntilIdle();
+    TestingBrowserProcess::GetGlobal()->SetLocalState(nullptr);
+  }
+
+ protected:
+  base::FilePath PerfDataPath(const std::string& name) const {
+    return test_data_dir_.AppendASCII(kPerfDataDir).AppendASCII(name);
+  }
+
+  void LoadCorpus() {
+    std::string json;
+    ASSERT_TRUE(base::ReadFileToString(PerfDataPath(kCorpusFile), &json));
+    base::Optional<base::Value> corpus = base::JSONReader::Read(json);
+    ASSERT_TRUE(corpus && corpus->is_dict());
+
+    const base::Value* pages = corpus->FindListKey("pages");
+    ASSERT_TRUE(pages);
+    for (const auto& page : pages->GetList()) {
+      const std::string* url = page.FindStringKey("url");
+      ASSERT_TRUE(url);
+      pages_.push_back({GURL(*url), StringsFromList(page.FindKey("classes")),
+                        StringsFromList(page.FindKey("ids"))});
+    }
+
+    const base::Value* requests = corpus->FindListKey("requests");
+    ASSERT_TRUE(requests);
+    for (const auto& request : requests->GetList()) {
+      const std::string* page = request.FindStringKey("page");
+      const std::string* url = request.FindStringKey("url");
+      const std::string* type = request.FindStringKey("type");
+      ASSERT_TRUE(page && url && type);
+      CorpusRequest corpus_request{GURL(*page), GURL(*url),
+                                   blink::mojom::ResourceType::kSubResource};
+      ASSERT_TRUE(ResourceTypeFromString(*type, &corpus_request.type))
+          << *type;
+      ASSERT_TRUE(corpus_request.page.is_valid() &&
+                  corpus_request.url.is_valid())
+          << *url;
+      requests_.push_back(std::move(corpus_request));
+    }
+    ASSERT_FALSE(requests_.empty());
+  }
+
+  void StartAdBlockService() {
+    std::string rules;
+    ASSERT_TRUE(base::ReadFileToString(PerfDataPath(kFilterListFile), &rules));
+    ad_block_service_ = std::make_unique<PerfAdBlockService>(&delegate_);
+    ad_block_service_->Start();
+    ad_block_service_->LoadRules(rules);
+  }
+
+  void StartRegionalServices() {
+    const base::FilePath fixture_dat =
+        test_data_dir_.AppendASCII("adblock-data")
+            .AppendASCII("adblock-regional")
+            .AppendASCII(kRegionalFixtureUUID)
+            .AppendASCII(base::StringPrintf("rs-%s.dat", kRegionalFixtureUUID));
+
+    std::vector<adblock::FilterList> catalog;
+    DictionaryPrefUpdate update(&local_state_, kAdBlockRegionalFilters);
+    for (size_t i = 0; i < kRegionalListCount; ++i) {
+      const std::string uuid = base::StringPrintf("PERF-LIST-%zu", i);
+      const std::string title = base::StringPrintf("Perf Filter List %zu", i);
+      const base::FilePath install_dir =
+          temp_dir_.GetPath().AppendASCII("adblock-regional").AppendASCII(uuid);
+      ASSERT_TRUE(base::CreateDirectory(install_dir));
+      ASSERT_TRUE(base::CopyFile(
+          fixture_dat,
+          install_dir.AppendASCII(base::StringPrintf("rs-%s.dat",
+                                                     uuid.c_str()))));
+      delegate_.SetInstallDir(title, install_dir);
+
+      catalog.push_back(adblock::FilterList(
+          uuid, "https://brave.com", title, {}, "https://support.brave.com",
+          "componentid" + std::to_string(i), "base64publickey",
+          "Filter list for performance tests"));
+      auto filter = std::make_unique<base::DictionaryValue>();
+      filter->SetBoolean("enabled", true);
+      update->Set(uuid, std::move(filter));
+    }
+    local_state_.SetBoolean(kAdBlockCheckedDefaultRegion, true);
+
+    regional_service_manager_ =
+        AdBlockRegionalServiceManagerFactory(&delegate_);
+    regional_service_manager_->SetRegionalCatalog(std::move(catalog));
+  }
+
+  void StartHTTPSEverywhereService() {
+    // The service unzips the database next to the archive, so it gets a copy
+    // of the fixture instead of the source tree.
+    const base::FilePath install_dir =
+        temp_dir_.GetPath().AppendASCII("https-everywhere-data");
+    ASSERT_TRUE(base::CopyDirectory(
+        test_data_dir_.AppendASCII("https-everywhere-data"), install_dir,
+        true));
+    delegate_.SetInstallDir(kHTTPSEverywhereComponentName, install_dir);
+
+    https_everywhere_service_ = HTTPSEverywhereServiceFactory(&delegate_);
+    https_everywhere_service_->Start();
+  }
+
+  void ExpectDefaultEngineLoaded() {
+    const GURL url(kDefaultBlockedURL);
+    bool did_match_rule = false;
+    bool did_match_exception = false;
+    bool did_match_important = false;
+    std::string mock_data_url;
+    ad_block_service_->ShouldStartRequest(
+        url, blink::mojom::ResourceType::kScript, "example.com",
+        &did_match_rule, &did_match_exception, &did_match_important,
+        &mock_data_url);
+    ASSERT_TRUE(did_match_rule);
+  }
+
+  // Checks every regional engine on its own, as the manager stops at the
+  // first important match.
+  void ExpectRegionalEnginesLoaded() {
+    ASSERT_TRUE(regional_service_manager_->IsInitialized());
+    base::AutoLock lock(regional_service_manager_->regional_services_lock_);
+    ASSERT_EQ(kRegionalListCount,
+              regional_service_manager_->regional_services_.size());
+    const GURL url(kRegionalBlockedURL);
+    for (const auto& regional_service :
+         regional_service_manager_->regional_services_) {
+      bool did_match_rule = false;
+      bool did_match_exception = false;
+      bool did_match_important = false;
+      std::string mock_data_url;
+      regional_service.second->ShouldStartRequest(
+          url, blink::mojom::ResourceType::kImage, url.host(),
+          &did_match_rule, &did_match_exception, &did_match_important,
+          &mock_data_url);
+      ASSERT_TRUE(did_match_rule) << regional_service.first;
+    }
+  }
+
+  content::BrowserTaskEnvironment task_environment_;
+  TestingPrefServiceSimple local_state_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath test_data_dir_;
+  PerfComponentDelegate delegate_;
+
+  std::vector<CorpusPage> pages_;
+  std::vector<CorpusRequest> requests_;
+
+  std::unique_ptr<PerfAdBlockService> ad_block_service_;
+  std::unique_ptr<AdBlockRegionalServiceManager> regional_service_manager_;
+  std::unique_ptr<HTTPSEverywhereService> https_everywhere_service_;
+};
+
+TEST_F(BraveShieldsPerfTest, RequestPath) {
+  const size_t malloc_before_load = GetMallocUsage();
+  ASSERT_NO_FATAL_FAILURE(StartAdBlockService());
+  ASSERT_NO_FATAL_FAILURE(StartRegionalServices());
+  ASSERT_NO_FATAL_FAILURE(StartHTTPSEverywhereService());
+  // Runs the posted component ready callbacks and DAT loads.
+  task_environment_.RunUntilIdle();
+  const size_t malloc_after_load = GetMallocUsage();
+  ASSERT_TRUE(https_everywhere_service_->IsInitialized());
+  ASSERT_NO_FATAL_FAILURE(ExpectDefaultEngineLoaded());
+  ASSERT_NO_FATAL_FAILURE(ExpectRegionalEnginesLoaded());
+
+  StageTimings ad_block_timings("ad_block.should_start_request");
+  StageTimings regional_timings("ad_block_regional.should_start_request");
+  StageTimings https_everywhere_timings("https_everywhere.get_https_url");
+  StageTimings cosmetic_resources_timings("ad_block.url_cosmetic_resources");
+  StageTimings hidden_selectors_timings("ad_block.hidden_class_id_selectors");
+
+  uint64_t request_id = 0;
+  size_t blocked = 0;
+  for (int iteration = 0; iteration < kIterations; ++iteration) {
+    const bool record = iteration > 0;
+
+    for (const CorpusRequest& request : requests_) {
+      const std::string tab_host = request.page.host();
+      bool did_match_rule = false;
+      bool did_match_exception = false;
+      bool did_match_important = false;
+      std::string mock_data_url;
+
+      base::TimeTicks start = base::TimeTicks::Now();
+      ad_block_service_->ShouldStartRequest(
+          request.url, request.type, tab_host, &did_match_rule,
+          &did_match_exception, &did_match_important, &mock_data_url);
+      base::TimeTicks end = base::TimeTicks::Now();
+      if (record)
+        ad_block_timings.Add(end - start);
+
+      start = base::TimeTicks::Now();
+      regional_service_manager_->ShouldStartRequest(
+          request.url, request.type, tab_host, &did_match_rule,
+          &did_match_exception, &did_match_important, &mock_data_url);
+      end = base::TimeTicks::Now();
+      if (record)
+        regional_timings.Add(end - start);
+
+      std::string new_url;
+      start = base::TimeTicks::Now();
+      https_everywhere_service_->GetHTTPSURL(&request.url, ++request_id,
+                                             &new_url);
+      end = base::TimeTicks::Now();
+      if (record)
+        https_everywhere_timings.Add(end - start);
+
+      if (iteration == 0 && did_match_rule && !did_match_exception)
+        ++blocked;
+    }
+
+    for (const CorpusPage& page : pages_) {
+      base::TimeTicks start = base::TimeTicks::Now();
+      base::Optional<base::Value> resources =
+          ad_block_service_->UrlCosmeticResources(page.url.spec());
+      regional_service_manager_->UrlCosmeticResources(page.url.spec());
+      base::TimeTicks end = base::TimeTicks::Now();
+      if (record)
+        cosmetic_resources_timings.Add(end - start);
+
+      std::vector<std::string> exceptions;
+      if (resources && resources->is_dict()) {
+        exceptions = StringsFromList(resources->FindKey("exceptions"));
+      }
+      start = base::TimeTicks::Now();
+      ad_block_service_->HiddenClassIdSelectors(page.classes, page.ids,
+                                                exceptions);
+      regional_service_manager_->HiddenClassIdSelectors(page.classes, page.ids,
+                                                        exceptions);
+      end = base::TimeTicks::Now();
+      if (record)
+        hidden_selectors_timings.Add(end - start);
+    }
+  }
+
+  // The corpus and filter list are built so that some requests are blocked;
+  // if none are, the engines didn't load and the timings are meaningless.
+  EXPECT_GT(blocked, 0u);
+
+  ad_block_timings.Report();
+  regional_timings.Report();
+  https_everywhere_timings.Report();
+  cosmetic_resources_timings.Report();
+  hidden_selectors_timings.Report();
+
+  perf_test::PerfResultReporter reporter("shields.memory", kStoryName);
+  reporter.RegisterImportantMetric(".engines_malloc", "bytes");
+  reporter.RegisterFyiMetric(".replay_malloc_growth", "bytes");
+  reporter.AddResult(".engines_malloc",
+                     malloc_after_load > malloc_before_load
+                         ? malloc_after_load - malloc_before_load
+                         : 0u);
+  const size_t malloc_after_replay = GetMallocUsage();
+  reporter.AddResult(".replay_malloc_growth",
+                     malloc_after_replay > malloc_after_load
+                         ? malloc_after_replay - malloc_after_load
+                         : 0u);
+}
+
+}  // namespace brave_shields
@@ -15,11 +15,11 @@
 #include "brave/common/pref_names.h"
 #include "brave/common/render_messages.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/renderer_content_setting_rules_cache.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/content/common/frame_messages.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/profiles/profile.h"
-#include "chrome/common/renderer_configuration.mojom.h"
 #include "components/content_settings/core/browser/host_content_settings_map.h"
 #include "components/content_settings/core/common/content_settings_utils.h"
 #include "components/prefs/pref_registry_simple.h"
@@ -35,7 +35,6 @@
 #include "content/public/browser/web_contents_user_data.h"
 #include "extensions/buildflags/buildflags.h"
 #include "ipc/ipc_message_macros.h"
-#include "mojo/public/cpp/bindings/associated_remote.h"
 
 #if BUILDFLAG(ENABLE_EXTENSIONS)
 #include "brave/common/extensions/api/brave_shields.h"
@@ -53,6 +52,26 @@ using content::WebContents;
 
 namespace {
 
+// User data key for the profile's RendererContentSettingRulesCache.
+const void* const kRendererContentSettingRulesCacheKey =
+    &kRendererContentSettingRulesCacheKey;
+
+brave_shields::RendererContentSettingRulesCache*
+GetRendererContentSettingRulesCache(content::BrowserContext* context) {
+  auto* cache = static_cast<brave_shields::RendererContentSettingRulesCache*>(
+      context->GetUserData(kRendererContentSettingRulesCacheKey));
+  if (!cache) {
+    auto new_cache =
+        std::make_unique<brave_shields::RendererContentSettingRulesCache>(
+            HostContentSettingsMapFactory::GetForProfile(
+                Profile::FromBrowserContext(context)));
+    cache = new_cache.get();
+    context->SetUserData(kRendererContentSettingRulesCacheKey,
+                         std::move(new_cache));
+  }
+  return cache;
+}
+
 // Content Settings are only sent to the main frame currently.
 // Chrome may fix this at some point, but for now we do this as a work-around.
 // You can verify if this is fixed by running the following test:
@@ -62,22 +81,8 @@ namespace {
 // tests by:
 // npm run test -- brave_browser_tests --filter=BraveContentSettingsAgentImplBrowserTest.*  // NOLINT
 void UpdateContentSettingsToRendererFrames(content::WebContents* web_contents) {
-  for (content::RenderFrameHost* frame : web_contents->GetAllFrames()) {
-    Profile* profile =
-        Profile::FromBrowserContext(web_contents->GetBrowserContext());
-    const HostContentSettingsMap* map =
-        HostContentSettingsMapFactory::GetForProfile(profile);
-    RendererContentSettingRules rules;
-    GetRendererContentSettingRules(map, &rules);
-    IPC::ChannelProxy* channel =
-        frame->GetProcess()->GetChannel();
-    // channel might be NULL in tests.
-    if (channel) {
-      mojo::AssociatedRemote<chrome::mojom::RendererConfiguration> rc_interface;
-      channel->GetRemoteAssociatedInterface(&rc_interface);
-      rc_interface->SetContentSettingRules(rules);
-    }
-  }
+  GetRendererContentSettingRulesCache(web_contents->GetBrowserContext())
+      ->SendRulesToFrames(web_contents);
 }
 
 WebContents* GetWebContents(
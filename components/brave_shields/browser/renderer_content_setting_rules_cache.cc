@@ -0,0 +1,157 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/renderer_content_setting_rules_cache.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
+#include "chrome/common/renderer_configuration.mojom.h"
+#include "components/content_settings/core/browser/content_settings_registry.h"
+#include "components/content_settings/core/browser/content_settings_utils.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/render_process_host_observer.h"
+#include "content/public/browser/web_contents.h"
+#include "ipc/ipc_channel_proxy.h"
+#include "mojo/public/cpp/bindings/associated_remote.h"
+
+namespace brave_shields {
+
+namespace {
+
+// User data key for the version of the rules a renderer process was sent.
+const void* const kSentRulesVersionKey = &kSentRulesVersionKey;
+
+// The host is reused when a crashed renderer is relaunched, and the new
+// renderer starts without any rules, so the version is reset when the
+// process exits.
+class SentRulesVersion : public base::SupportsUserData::Data,
+                         public content::RenderProcessHostObserver {
+ public:
+  SentRulesVersion(content::RenderProcessHost* host, uint64_t version)
+      : version_(version) {
+    observer_.Add(host);
+  }
+  ~SentRulesVersion() override = default;
+
+  SentRulesVersion(const SentRulesVersion&) = delete;
+  SentRulesVersion& operator=(const SentRulesVersion&) = delete;
+
+  uint64_t version() const { return version_; }
+  void set_version(uint64_t version) { version_ = version; }
+
+ private:
+  // content::RenderProcessHostObserver overrides:
+  void RenderProcessExited(
+      content::RenderProcessHost* host,
+      const content::ChildProcessTerminationInfo& info) override {
+    version_ = 0;
+  }
+  void RenderProcessHostDestroyed(content::RenderProcessHost* host) override {
+    observer_.Remove(host);
+  }
+
+  uint64_t version_;
+  ScopedObserver<content::RenderProcessHost, content::RenderProcessHostObserver>
+      observer_{this};
+};
+
+// Shared by every profile so that a version never matches rules that were
+// built for another one.
+uint64_t g_next_rules_version = 1;
+
+bool SendRulesOverChannel(content::RenderProcessHost* process,
+                          const RendererContentSettingRules& rules) {
+  IPC::ChannelProxy* channel = process->GetChannel();
+  // channel might be NULL in tests.
+  if (!channel)
+    return false;
+  mojo::AssociatedRemote<chrome::mojom::RendererConfiguration> rc_interface;
+  channel->GetRemoteAssociatedInterface(&rc_interface);
+  rc_interface->SetContentSettingRules(rules);
+  return true;
+}
+
+}  // namespace
+
+RendererContentSettingRulesCache::RendererContentSettingRulesCache(
+    HostContentSettingsMap* map)
+    : map_(map),
+      send_rules_callback_(base::BindRepeating(&SendRulesOverChannel)) {
+  observer_.Add(map);
+}
+
+RendererContentSettingRulesCache::~RendererContentSettingRulesCache() =
+    default;
+
+scoped_refptr<const RendererContentSettingRulesCache::Rules>
+RendererContentSettingRulesCache::GetRules() {
+  if (!rules_) {
+    auto rules = base::MakeRefCounted<Rules>();
+    GetRendererContentSettingRules(map_.get(), &rules->data);
+    rules_ = std::move(rules);
+    version_ = g_next_rules_version++;
+    ++build_count_;
+  }
+  return rules_;
+}
+
+bool RendererContentSettingRulesCache::HasCurrentRules(
+    content::RenderProcessHost* process) {
+  GetRules();
+  const auto* sent = static_cast<SentRulesVersion*>(
+      process->GetUserData(kSentRulesVersionKey));
+  return sent && sent->version() == version_;
+}
+
+void RendererContentSettingRulesCache::MarkRulesSent(
+    content::RenderProcessHost* process) {
+  DCHECK(rules_);
+  auto* sent = static_cast<SentRulesVersion*>(
+      process->GetUserData(kSentRulesVersionKey));
+  if (sent) {
+    sent->set_version(version_);
+    return;
+  }
+  process->SetUserData(kSentRulesVersionKey,
+                       std::make_unique<SentRulesVersion>(process, version_));
+}
+
+void RendererContentSettingRulesCache::SendRulesToFrames(
+    content::WebContents* web_contents) {
+  scoped_refptr<const Rules> rules = GetRules();
+  for (content::RenderFrameHost* frame : web_contents->GetAllFrames()) {
+    content::RenderProcessHost* process = frame->GetProcess();
+    // The rules are set per renderer process, so frames sharing a process
+    // with another frame or tab only need them once per settings change.
+    if (HasCurrentRules(process))
+      continue;
+    if (send_rules_callback_.Run(process, rules->data))
+      MarkRulesSent(process);
+  }
+}
+
+void RendererContentSettingRulesCache::SetSendRulesCallbackForTesting(
+    SendRulesCallback callback) {
+  send_rules_callback_ = std::move(callback);
+}
+
+void RendererContentSettingRulesCache::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type) {
+  // The rules only hold content settings, so frequently updated website
+  // settings such as site engagement don't need a rebuild.
+  if (content_type != ContentSettingsType::DEFAULT &&
+      !content_settings::ContentSettingsRegistry::GetInstance()->Get(
+          content_type)) {
+    return;
+  }
+  rules_ = nullptr;
+}
+
+}  // namespace brave_shields
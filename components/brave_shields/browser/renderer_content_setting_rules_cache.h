@@ -0,0 +1,84 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_RENDERER_CONTENT_SETTING_RULES_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_RENDERER_CONTENT_SETTING_RULES_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/callback.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/scoped_observer.h"
+#include "base/supports_user_data.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "components/content_settings/core/common/content_settings.h"
+
+namespace content {
+class RenderProcessHost;
+class WebContents;
+}  // namespace content
+
+namespace brave_shields {
+
+// Builds the RendererContentSettingRules of a profile once per content
+// settings change and shares them between all of its tabs, and remembers
+// which renderer processes already have them. One instance per profile, used
+// on the UI thread only.
+class RendererContentSettingRulesCache : public base::SupportsUserData::Data,
+                                         public content_settings::Observer {
+ public:
+  using Rules = base::RefCountedData<RendererContentSettingRules>;
+  // Sends |rules| to |process| and returns whether they were sent.
+  using SendRulesCallback =
+      base::RepeatingCallback<bool(content::RenderProcessHost* process,
+                                   const RendererContentSettingRules& rules)>;
+
+  explicit RendererContentSettingRulesCache(HostContentSettingsMap* map);
+  ~RendererContentSettingRulesCache() override;
+
+  RendererContentSettingRulesCache(const RendererContentSettingRulesCache&) =
+      delete;
+  RendererContentSettingRulesCache& operator=(
+      const RendererContentSettingRulesCache&) = delete;
+
+  // Returns the rules for the current settings.
+  scoped_refptr<const Rules> GetRules();
+
+  // Whether |process| was last sent the rules that |GetRules| returns now.
+  bool HasCurrentRules(content::RenderProcessHost* process);
+  void MarkRulesSent(content::RenderProcessHost* process);
+
+  // Sends the current rules to each renderer process hosting a frame of
+  // |web_contents| that doesn't have them yet.
+  void SendRulesToFrames(content::WebContents* web_contents);
+
+  void SetSendRulesCallbackForTesting(SendRulesCallback callback);
+
+  size_t build_count_for_testing() const { return build_count_; }
+
+ private:
+  // content_settings::Observer overrides:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type) override;
+
+  // Held so that removing the observer on destruction stays safe after the
+  // profile's keyed services have shut down.
+  scoped_refptr<HostContentSettingsMap> map_;
+  ScopedObserver<HostContentSettingsMap, content_settings::Observer>
+      observer_{this};
+  SendRulesCallback send_rules_callback_;
+  scoped_refptr<const Rules> rules_;
+  // Identifies |rules_| across all profiles; 0 until rules are built.
+  uint64_t version_ = 0;
+  size_t build_count_ = 0;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_RENDERER_CONTENT_SETTING_RULES_CACHE_H_
@@ -0,0 +1,192 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/renderer_content_setting_rules_cache.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/values.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/test/base/chrome_render_view_host_test_harness.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/site_instance.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/mock_render_process_host.h"
+#include "content/public/test/test_renderer_host.h"
+#include "content/public/test/web_contents_tester.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+
+constexpr size_t kSiteInstanceCount = 4;
+constexpr size_t kTabCount = 50;
+constexpr size_t kChildFramesPerTab = 5;
+
+}  // namespace
+
+class RendererContentSettingRulesCacheTest
+    : public ChromeRenderViewHostTestHarness {
+ public:
+  RendererContentSettingRulesCacheTest() = default;
+  ~RendererContentSettingRulesCacheTest() override = default;
+
+  void SetUp() override {
+    ChromeRenderViewHostTestHarness::SetUp();
+
+    cache_ = std::make_unique<RendererContentSettingRulesCache>(map());
+    cache_->SetSendRulesCallbackForTesting(base::BindRepeating(
+        &RendererContentSettingRulesCacheTest::CountSendRules,
+        base::Unretained(this)));
+
+    // Tabs of the same site instance share a renderer process.
+    std::vector<scoped_refptr<content::SiteInstance>> site_instances;
+    for (size_t i = 0; i < kSiteInstanceCount; ++i)
+      site_instances.push_back(content::SiteInstance::Create(profile()));
+
+    for (size_t tab = 0; tab < kTabCount; ++tab) {
+      std::unique_ptr<content::WebContents> contents =
+          content::WebContentsTester::CreateTestWebContents(
+              profile(), site_instances[tab % kSiteInstanceCount]);
+      content::RenderFrameHostTester* main_frame_tester =
+          content::RenderFrameHostTester::For(contents->GetMainFrame());
+      main_frame_tester->InitializeRenderFrameIfNeeded();
+      for (size_t frame = 0; frame < kChildFramesPerTab; ++frame)
+        main_frame_tester->AppendChild("child");
+      tabs_.push_back(std::move(contents));
+    }
+  }
+
+  void TearDown() override {
+    tabs_.clear();
+    cache_.reset();
+    ChromeRenderViewHostTestHarness::TearDown();
+  }
+
+  HostContentSettingsMap* map() {
+    return HostContentSettingsMapFactory::GetForProfile(profile());
+  }
+
+  RendererContentSettingRulesCache* cache() { return cache_.get(); }
+
+  std::set<content::RenderProcessHost*> GetProcesses() {
+    std::set<content::RenderProcessHost*> processes;
+    for (const auto& tab : tabs_) {
+      for (content::RenderFrameHost* frame : tab->GetAllFrames())
+        processes.insert(frame->GetProcess());
+    }
+    return processes;
+  }
+
+  // Does what the web contents observer does when a frame is created in
+  // every open tab, and returns the number of SetContentSettingRules calls.
+  size_t SendRulesToAllTabs() {
+    sent_.clear();
+    for (const auto& tab : tabs_)
+      cache()->SendRulesToFrames(tab.get());
+
+    size_t sent = 0;
+    for (const auto& process_and_count : sent_) {
+      // No process is ever sent the same rules twice.
+      EXPECT_EQ(1u, process_and_count.second);
+      sent += process_and_count.second;
+    }
+    return sent;
+  }
+
+ private:
+  bool CountSendRules(content::RenderProcessHost* process,
+                      const RendererContentSettingRules& rules) {
+    ++sent_[process];
+    return true;
+  }
+
+  std::unique_ptr<RendererContentSettingRulesCache> cache_;
+  std::vector<std::unique_ptr<content::WebContents>> tabs_;
+  std::map<content::RenderProcessHost*, size_t> sent_;
+};
+
+TEST_F(RendererContentSettingRulesCacheTest, MatchesContentSettings) {
+  map()->SetDefaultContentSetting(ContentSettingsType::JAVASCRIPT,
+                                  CONTENT_SETTING_BLOCK);
+
+  RendererContentSettingRules expected;
+  GetRendererContentSettingRules(map(), &expected);
+
+  const RendererContentSettingRules& rules = cache()->GetRules()->data;
+  EXPECT_EQ(expected.script_rules, rules.script_rules);
+  EXPECT_EQ(expected.image_rules, rules.image_rules);
+}
+
+TEST_F(RendererContentSettingRulesCacheTest, SendsOncePerProcess) {
+  const size_t process_count = GetProcesses().size();
+  ASSERT_LT(process_count, kTabCount);
+
+  EXPECT_EQ(process_count, SendRulesToAllTabs());
+  EXPECT_EQ(1u, cache()->build_count_for_testing());
+
+  // Nothing changed, so no process needs the rules again.
+  EXPECT_EQ(0u, SendRulesToAllTabs());
+  EXPECT_EQ(1u, cache()->build_count_for_testing());
+}
+
+TEST_F(RendererContentSettingRulesCacheTest, ContentSettingChangeResends) {
+  SendRulesToAllTabs();
+  auto rules = cache()->GetRules();
+
+  map()->SetContentSettingDefaultScope(GURL("https://brave.com"), GURL(),
+                                       ContentSettingsType::IMAGES,
+                                       CONTENT_SETTING_BLOCK);
+
+  EXPECT_NE(rules, cache()->GetRules());
+  EXPECT_EQ(GetProcesses().size(), SendRulesToAllTabs());
+  EXPECT_EQ(2u, cache()->build_count_for_testing());
+}
+
+TEST_F(RendererContentSettingRulesCacheTest, WebsiteSettingChangeIsIgnored) {
+  SendRulesToAllTabs();
+
+  map()->SetWebsiteSettingDefaultScope(
+      GURL("https://brave.com"), GURL(), ContentSettingsType::SITE_ENGAGEMENT,
+      std::make_unique<base::DictionaryValue>());
+
+  EXPECT_EQ(0u, SendRulesToAllTabs());
+  EXPECT_EQ(1u, cache()->build_count_for_testing());
+}
+
+TEST_F(RendererContentSettingRulesCacheTest, CrashedProcessIsResent) {
+  SendRulesToAllTabs();
+
+  // The host is reused for the relaunched renderer, which has no rules yet.
+  content::RenderProcessHost* crashed_process = *GetProcesses().begin();
+  static_cast<content::MockRenderProcessHost*>(crashed_process)
+      ->SimulateCrash();
+
+  EXPECT_FALSE(cache()->HasCurrentRules(crashed_process));
+  EXPECT_EQ(1u, SendRulesToAllTabs());
+  EXPECT_TRUE(cache()->HasCurrentRules(crashed_process));
+  EXPECT_EQ(1u, cache()->build_count_for_testing());
+}
+
+TEST_F(RendererContentSettingRulesCacheTest, CachesAreIndependent) {
+  SendRulesToAllTabs();
+
+  // Rules sent for another profile never count as current.
+  RendererContentSettingRulesCache other_cache(map());
+  for (content::RenderProcessHost* process : GetProcesses()) {
+    EXPECT_TRUE(cache()->HasCurrentRules(process));
+    EXPECT_FALSE(other_cache.HasCurrentRules(process));
+  }
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,74 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_decision_cache.h"
+
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+
+// A long browsing session visits many origins; start over rather than grow
+// without bound.
+constexpr size_t kMaxCachedOrigins = 256;
+
+}  // namespace
+
+ShieldsDecisionCache::ShieldsDecisionCache(HostContentSettingsMap* map)
+    : map_(map) {
+  observer_.Add(map);
+}
+
+ShieldsDecisionCache::~ShieldsDecisionCache() = default;
+
+ShieldsDecisions ShieldsDecisionCache::Get(const GURL& url) {
+  if (!url.SchemeIsHTTPOrHTTPS())
+    return Resolve(url);
+
+  const GURL origin = url.GetOrigin();
+  auto it = decisions_.find(origin.spec());
+  if (it != decisions_.end())
+    return it->second;
+
+  if (decisions_.size() >= kMaxCachedOrigins)
+    decisions_.clear();
+
+  const ShieldsDecisions decisions = Resolve(origin);
+  decisions_.emplace(origin.spec(), decisions);
+  return decisions;
+}
+
+ShieldsDecisions ShieldsDecisionCache::Resolve(const GURL& url) const {
+  ShieldsDecisions decisions;
+  decisions.shields_enabled = GetBraveShieldsEnabled(map_.get(), url);
+  decisions.allow_ads =
+      GetAdControlType(map_.get(), url) == ControlType::ALLOW;
+  decisions.allow_http_upgradable_resource =
+      !GetHTTPSEverywhereEnabled(map_.get(), url);
+  decisions.allow_referrers = AllowReferrers(map_.get(), url);
+  return decisions;
+}
+
+void ShieldsDecisionCache::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type) {
+  switch (content_type) {
+    // DEFAULT means that settings of every type may have changed.
+    case ContentSettingsType::DEFAULT:
+    case ContentSettingsType::BRAVE_SHIELDS:
+    case ContentSettingsType::BRAVE_ADS:
+    case ContentSettingsType::BRAVE_HTTP_UPGRADABLE_RESOURCES:
+    case ContentSettingsType::BRAVE_REFERRERS:
+      decisions_.clear();
+      return;
+    default:
+      return;
+  }
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,65 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_DECISION_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_DECISION_CACHE_H_
+
+#include <string>
+#include <unordered_map>
+
+#include "base/memory/scoped_refptr.h"
+#include "base/scoped_observer.h"
+#include "base/supports_user_data.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+
+class GURL;
+
+namespace brave_shields {
+
+// The shields settings that every request made under a given origin needs.
+struct ShieldsDecisions {
+  bool shields_enabled = true;
+  bool allow_ads = false;
+  bool allow_http_upgradable_resource = false;
+  bool allow_referrers = false;
+};
+
+// Remembers the shields settings resolved for each origin, so that the
+// subresources of a page share one set of HostContentSettingsMap lookups.
+// Everything is dropped as soon as any of the underlying content settings
+// change. One instance per profile, used on the UI thread only.
+class ShieldsDecisionCache : public base::SupportsUserData::Data,
+                             public content_settings::Observer {
+ public:
+  explicit ShieldsDecisionCache(HostContentSettingsMap* map);
+  ~ShieldsDecisionCache() override;
+
+  ShieldsDecisionCache(const ShieldsDecisionCache&) = delete;
+  ShieldsDecisionCache& operator=(const ShieldsDecisionCache&) = delete;
+
+  // Returns the settings for the origin of |url|. Only http(s) origins are
+  // cached; anything else is looked up directly.
+  ShieldsDecisions Get(const GURL& url);
+
+ private:
+  ShieldsDecisions Resolve(const GURL& url) const;
+
+  // content_settings::Observer overrides:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type) override;
+
+  // Held so that removing the observer on destruction stays safe after the
+  // profile's keyed services have shut down.
+  scoped_refptr<HostContentSettingsMap> map_;
+  ScopedObserver<HostContentSettingsMap, content_settings::Observer>
+      observer_{this};
+  std::unordered_map<std::string, ShieldsDecisions> decisions_;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_DECISION_CACHE_H_
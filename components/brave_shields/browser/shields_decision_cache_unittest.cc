@@ -0,0 +1,105 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_decision_cache.h"
+
+#include <memory>
+
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+class ShieldsDecisionCacheTest : public testing::Test {
+ public:
+  ShieldsDecisionCacheTest() = default;
+  ~ShieldsDecisionCacheTest() override = default;
+
+  void SetUp() override {
+    profile_ = std::make_unique<TestingProfile>();
+    cache_ = std::make_unique<ShieldsDecisionCache>(map());
+  }
+
+  HostContentSettingsMap* map() {
+    return HostContentSettingsMapFactory::GetForProfile(profile_.get());
+  }
+
+  ShieldsDecisionCache* cache() { return cache_.get(); }
+
+  void ExpectMatchesMap(const GURL& url) {
+    const ShieldsDecisions decisions = cache()->Get(url);
+    EXPECT_EQ(GetBraveShieldsEnabled(map(), url), decisions.shields_enabled)
+        << url;
+    EXPECT_EQ(GetAdControlType(map(), url) == ControlType::ALLOW,
+              decisions.allow_ads)
+        << url;
+    EXPECT_EQ(!GetHTTPSEverywhereEnabled(map(), url),
+              decisions.allow_http_upgradable_resource)
+        << url;
+    EXPECT_EQ(AllowReferrers(map(), url), decisions.allow_referrers) << url;
+  }
+
+ private:
+  content::BrowserTaskEnvironment task_environment_;
+  std::unique_ptr<TestingProfile> profile_;
+  std::unique_ptr<ShieldsDecisionCache> cache_;
+};
+
+TEST_F(ShieldsDecisionCacheTest, MatchesContentSettings) {
+  SetBraveShieldsEnabled(map(), false, GURL("https://brave.com"));
+  SetAdControlType(map(), ControlType::ALLOW, GURL("https://example.com"));
+  SetHTTPSEverywhereEnabled(map(), false, GURL("http://example.com"));
+  SetCookieControlType(map(), ControlType::ALLOW, GURL("https://example.com"));
+
+  const GURL urls[] = {
+      GURL(),
+      GURL("https://brave.com"),
+      GURL("http://brave.com:8080/path"),
+      GURL("https://example.com/"),
+      GURL("https://sub.example.com/"),
+      GURL("https://other.com/"),
+      GURL("chrome://settings"),
+  };
+  for (const GURL& url : urls) {
+    // Once to fill the cache, then again to read from it.
+    ExpectMatchesMap(url);
+    ExpectMatchesMap(url);
+  }
+}
+
+TEST_F(ShieldsDecisionCacheTest, SharedAcrossPathsOfAnOrigin) {
+  SetAdControlType(map(), ControlType::ALLOW, GURL("https://brave.com"));
+
+  EXPECT_TRUE(cache()->Get(GURL("https://brave.com/a")).allow_ads);
+  EXPECT_TRUE(cache()->Get(GURL("https://brave.com/b?c=d")).allow_ads);
+  EXPECT_FALSE(cache()->Get(GURL("https://brave2.com/a")).allow_ads);
+}
+
+TEST_F(ShieldsDecisionCacheTest, DroppedWhenSettingsChange) {
+  const GURL url("https://brave.com/");
+  ExpectMatchesMap(url);
+
+  SetBraveShieldsEnabled(map(), false, url);
+  EXPECT_FALSE(cache()->Get(url).shields_enabled);
+
+  SetAdControlType(map(), ControlType::ALLOW, url);
+  EXPECT_TRUE(cache()->Get(url).allow_ads);
+
+  SetHTTPSEverywhereEnabled(map(), false, url);
+  EXPECT_TRUE(cache()->Get(url).allow_http_upgradable_resource);
+
+  SetCookieControlType(map(), ControlType::ALLOW, url);
+  EXPECT_TRUE(cache()->Get(url).allow_referrers);
+
+  ResetBraveShieldsEnabled(map(), url);
+  EXPECT_TRUE(cache()->Get(url).shields_enabled);
+}
+
+}  // namespace brave_shields
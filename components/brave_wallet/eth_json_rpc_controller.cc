@@ -5,15 +5,22 @@
 
 #include "brave/components/brave_wallet/eth_json_rpc_controller.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
+#include "base/bind.h"
 #include "base/environment.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/components/brave_wallet/eth_call_data_builder.h"
 #include "brave/components/brave_wallet/eth_requests.h"
 #include "brave/components/brave_wallet/eth_response_parser.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/storage_partition.h"
 #include "net/base/load_flags.h"
+#include "net/http/http_status_code.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
 
@@ -44,6 +51,14 @@ net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
 
 const unsigned int kRetriesCountOnNetworkChange = 1;
 
+// How long calls are held back so that a burst of them, such as one balance
+// lookup per token, goes out as a single batch.
+const int kBatchWindowMs = 20;
+
+// Upper bound on how long a "latest" block result is served from cache when
+// no new block number has been observed. Roughly one mainnet block interval.
+const int kCacheLifetimeSeconds = 15;
+
 std::string GetInfuraProjectID() {
   std::string project_id(BRAVE_INFURA_PROJECT_ID);
   std::unique_ptr<base::Environment> env(base::Environment::Create());
@@ -65,9 +80,23 @@ bool GetUseStagingInfuraEndpoint() {
 
 namespace brave_wallet {
 
+EthJsonRpcController::PendingCall::PendingCall(const std::string& json_payload,
+                                               bool cacheable)
+    : json_payload(json_payload), cacheable(cacheable) {}
+
+EthJsonRpcController::PendingCall::~PendingCall() = default;
+
 EthJsonRpcController::EthJsonRpcController(content::BrowserContext* context,
                                            Network network)
-    : context_(context), network_(network) {
+    : EthJsonRpcController(
+          content::BrowserContext::GetDefaultStoragePartition(context)
+              ->GetURLLoaderFactoryForBrowserProcess(),
+          network) {}
+
+EthJsonRpcController::EthJsonRpcController(
+    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
+    Network network)
+    : url_loader_factory_(std::move(url_loader_factory)), network_(network) {
   SetNetwork(network);
 }
 
@@ -94,14 +123,8 @@ void EthJsonRpcController::Request(const std::string& json_payload,
           ? network::SimpleURLLoader::RetryMode::RETRY_ON_NETWORK_CHANGE
           : network::SimpleURLLoader::RetryMode::RETRY_NEVER);
   auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
-
-  auto* default_storage_partition =
-      content::BrowserContext::GetDefaultStoragePartition(context_);
-  auto* url_loader_factory =
-      default_storage_partition->GetURLLoaderFactoryForBrowserProcess().get();
-
   iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
-      url_loader_factory,
+      url_loader_factory_.get(),
       base::BindOnce(&EthJsonRpcController::OnURLLoaderComplete,
                      base::Unretained(this), std::move(iter),
                      std::move(callback)));
@@ -132,6 +155,164 @@ void EthJsonRpcController::OnURLLoaderComplete(
                           headers);
 }
 
+void EthJsonRpcController::BatchRequest(const std::string& json_payload,
+                                        bool cacheable,
+                                        URLRequestCallback callback) {
+  if (cacheable) {
+    auto cached = response_cache_.find(json_payload);
+    if (cached != response_cache_.end()) {
+      if (cached->second.expiry > base::TimeTicks::Now()) {
+        base::SequencedTaskRunnerHandle::Get()->PostTask(
+            FROM_HERE,
+            base::BindOnce(std::move(callback), net::HTTP_OK,
+                           cached->second.body,
+                           std::map<std::string, std::string>()));
+        return;
+      }
+      response_cache_.erase(cached);
+    }
+  }
+
+  auto existing = calls_by_payload_.find(json_payload);
+  if (existing != calls_by_payload_.end()) {
+    existing->second->callbacks.push_back(std::move(callback));
+    return;
+  }
+
+  pending_calls_.push_back(
+      std::make_unique<PendingCall>(json_payload, cacheable));
+  PendingCall* call = pending_calls_.back().get();
+  call->callbacks.push_back(std::move(callback));
+  calls_by_payload_[json_payload] = call;
+
+  if (!batch_timer_.IsRunning()) {
+    batch_timer_.Start(FROM_HERE,
+                       base::TimeDelta::FromMilliseconds(kBatchWindowMs), this,
+                       &EthJsonRpcController::FlushPendingCalls);
+  }
+}
+
+void EthJsonRpcController::FlushPendingCalls() {
+  batch_timer_.Stop();
+  if (pending_calls_.empty())
+    return;
+
+  PendingCalls calls = std::move(pending_calls_);
+  pending_calls_.clear();
+
+  // A lone call goes out unchanged so that servers without batch support
+  // keep working for the common case.
+  std::string json_payload;
+  if (calls.size() == 1) {
+    json_payload = calls.front()->json_payload;
+  } else {
+    // Responses to a batch may come back in any order, so every call gets
+    // its index as id. A trailing eth_blockNumber tells whether cached
+    // results are still current.
+    base::Value batch(base::Value::Type::LIST);
+    bool has_cacheable_call = false;
+    for (size_t i = 0; i < calls.size(); ++i) {
+      base::Optional<base::Value> call =
+          base::JSONReader::Read(calls[i]->json_payload);
+      if (!call || !call->is_dict())
+        continue;
+      call->SetIntKey("id", static_cast<int>(i));
+      batch.Append(std::move(*call));
+      has_cacheable_call |= calls[i]->cacheable;
+    }
+    if (has_cacheable_call) {
+      base::Optional<base::Value> block_number =
+          base::JSONReader::Read(eth_blockNumber());
+      DCHECK(block_number && block_number->is_dict());
+      block_number->SetIntKey("id", static_cast<int>(calls.size()));
+      batch.Append(std::move(*block_number));
+    }
+    base::JSONWriter::Write(batch, &json_payload);
+  }
+
+  Request(json_payload,
+          base::BindOnce(&EthJsonRpcController::OnBatchResponse,
+                         base::Unretained(this), std::move(calls),
+                         network_url_),
+          true);
+}
+
+void EthJsonRpcController::OnBatchResponse(
+    PendingCalls calls,
+    const GURL& network_url,
+    const int status,
+    const std::string& body,
+    const std::map<std::string, std::string>& headers) {
+  for (const auto& call : calls) {
+    auto iter = calls_by_payload_.find(call->json_payload);
+    if (iter != calls_by_payload_.end() && iter->second == call.get())
+      calls_by_payload_.erase(iter);
+  }
+
+  const bool success = status >= 200 && status <= 299;
+  // Anything that can't be split up is handed to every caller as is and left
+  // for the response parsers to reject.
+  std::vector<std::string> responses(calls.size(), body);
+  std::vector<bool> has_result(calls.size(), false);
+  if (success) {
+    base::Optional<base::Value> value = base::JSONReader::Read(body);
+    if (calls.size() == 1) {
+      has_result[0] =
+          value && value->is_dict() && value->FindKey("result") != nullptr;
+    } else if (value && value->is_list()) {
+      std::fill(responses.begin(), responses.end(), std::string());
+      for (const auto& response : value->GetList()) {
+        if (!response.is_dict())
+          continue;
+        base::Optional<int> id = response.FindIntKey("id");
+        if (!id || *id < 0 || static_cast<size_t>(*id) > calls.size())
+          continue;
+        if (static_cast<size_t>(*id) == calls.size()) {
+          const std::string* block_number = response.FindStringKey("result");
+          if (block_number && network_url == network_url_)
+            UpdateBlockNumber(*block_number);
+          continue;
+        }
+        base::JSONWriter::Write(response, &responses[*id]);
+        has_result[*id] = response.FindKey("result") != nullptr;
+      }
+    }
+  }
+
+  // Results for a network that has since been switched away from must not
+  // be served to later calls.
+  if (network_url == network_url_) {
+    const base::TimeTicks expiry =
+        base::TimeTicks::Now() +
+        base::TimeDelta::FromSeconds(kCacheLifetimeSeconds);
+    for (size_t i = 0; i < calls.size(); ++i) {
+      if (calls[i]->cacheable && has_result[i])
+        response_cache_[calls[i]->json_payload] = {responses[i], expiry};
+    }
+  }
+
+  for (size_t i = 0; i < calls.size(); ++i) {
+    for (auto& callback : calls[i]->callbacks)
+      std::move(callback).Run(status, responses[i], headers);
+  }
+}
+
+void EthJsonRpcController::UpdateBlockNumber(const std::string& block_number) {
+  if (block_number == block_number_)
+    return;
+  block_number_ = block_number;
+  response_cache_.clear();
+}
+
+void EthJsonRpcController::ResetPendingState() {
+  // Queued calls were made against the current network, so send them there
+  // before it changes.
+  FlushPendingCalls();
+  calls_by_payload_.clear();
+  response_cache_.clear();
+  block_number_.clear();
+}
+
 Network EthJsonRpcController::GetNetwork() const {
   return network_;
 }
@@ -141,6 +322,7 @@ GURL EthJsonRpcController::GetNetworkURL() const {
 }
 
 void EthJsonRpcController::SetNetwork(Network network) {
+  ResetPendingState();
   std::string subdomain;
   network_ = network;
   switch (network) {
@@ -175,6 +357,7 @@ void EthJsonRpcController::SetNetwork(Network network) {
 }
 
 void EthJsonRpcController::SetCustomNetwork(const GURL& network_url) {
+  ResetPendingState();
   network_ = Network::kCustom;
   network_url_ = network_url;
 }
@@ -185,8 +368,8 @@ void EthJsonRpcController::GetBalance(
   auto internal_callback =
       base::BindOnce(&EthJsonRpcController::OnGetBalance,
                      base::Unretained(this), std::move(callback));
-  return Request(eth_getBalance(address, "latest"),
-                 std::move(internal_callback), true);
+  BatchRequest(eth_getBalance(address, "latest"), true,
+               std::move(internal_callback));
 }
 
 void EthJsonRpcController::OnGetBalance(
@@ -218,8 +401,8 @@ bool EthJsonRpcController::GetERC20TokenBalance(
   if (!erc20::BalanceOf(address, &data)) {
     return false;
   }
-  Request(eth_call("", address, "", "", "", data, ""),
-          std::move(internal_callback), true);
+  BatchRequest(eth_call("", contract, "", "", "", data, "latest"), true,
+               std::move(internal_callback));
   return true;
 }
 
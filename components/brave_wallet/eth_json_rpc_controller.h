@@ -10,8 +10,12 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "brave/components/brave_wallet/brave_wallet_constants.h"
 #include "url/gurl.h"
 
@@ -20,6 +24,7 @@ class BrowserContext;
 }  // namespace content
 
 namespace network {
+class SharedURLLoaderFactory;
 class SimpleURLLoader;
 }  // namespace network
 
@@ -28,12 +33,16 @@ namespace brave_wallet {
 class EthJsonRpcController {
  public:
   EthJsonRpcController(content::BrowserContext* context, Network network);
+  EthJsonRpcController(
+      scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
+      Network network);
   ~EthJsonRpcController();
 
   using URLRequestCallback =
       base::OnceCallback<void(const int,
                               const std::string&,
                               const std::map<std::string, std::string>&)>;
+  // Sends |json_payload| as is in its own request.
   void Request(const std::string& json_payload,
                URLRequestCallback callback,
                bool auto_retry_on_network_change);
@@ -57,6 +66,39 @@ class EthJsonRpcController {
   static GURL GetBlockTrackerURLFromNetwork(Network network);
 
  private:
+  // A call queued for, or in flight in, a batched request. Identical payloads
+  // share one call and every caller's callback is run with its response.
+  struct PendingCall {
+    PendingCall(const std::string& json_payload, bool cacheable);
+    ~PendingCall();
+
+    std::string json_payload;
+    // Whether the result is scoped to the latest block and may be served from
+    // |response_cache_| until a new block is seen.
+    bool cacheable;
+    std::vector<URLRequestCallback> callbacks;
+  };
+  using PendingCalls = std::vector<std::unique_ptr<PendingCall>>;
+
+  struct CachedResponse {
+    std::string body;
+    base::TimeTicks expiry;
+  };
+
+  // Queues |json_payload| for the next batched request. Calls made within
+  // |kBatchWindowMs| of each other are sent as a single JSON-RPC batch.
+  void BatchRequest(const std::string& json_payload,
+                    bool cacheable,
+                    URLRequestCallback callback);
+  void FlushPendingCalls();
+  void OnBatchResponse(PendingCalls calls,
+                       const GURL& network_url,
+                       const int status,
+                       const std::string& body,
+                       const std::map<std::string, std::string>& headers);
+  void UpdateBlockNumber(const std::string& block_number);
+  void ResetPendingState();
+
   using SimpleURLLoaderList =
       std::list<std::unique_ptr<network::SimpleURLLoader>>;
   void OnURLLoaderComplete(SimpleURLLoaderList::iterator iter,
@@ -72,10 +114,17 @@ class EthJsonRpcController {
       const std::string& body,
       const std::map<std::string, std::string>& headers);
 
-  content::BrowserContext* context_;
+  scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   GURL network_url_;
   SimpleURLLoaderList url_loaders_;
   Network network_;
+
+  PendingCalls pending_calls_;
+  // Queued and in-flight calls keyed by payload, for request de-duplication.
+  std::map<std::string, PendingCall*> calls_by_payload_;
+  std::map<std::string, CachedResponse> response_cache_;
+  std::string block_number_;
+  base::OneShotTimer batch_timer_;
 };
 
 }  // namespace brave_wallet
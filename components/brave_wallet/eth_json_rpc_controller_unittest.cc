@@ -4,28 +4,111 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "base/json/json_reader.h"
+#include "base/test/bind.h"
+#include "base/values.h"
 #include "brave/components/brave_wallet/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/eth_json_rpc_controller.h"
 #include "content/public/test/browser_task_environment.h"
 #include "content/public/test/test_browser_context.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "services/network/test/test_utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "url/gurl.h"
 
 namespace brave_wallet {
 
+namespace {
+
+const char kNetworkURL[] = "https://eth.example.com/";
+
+const char kAddress1[] = "0x4e02f254184E904300e0775E4b8eeCB1";
+const char kAddress2[] = "0x2e02f254184E904300e0775E4b8eeCB2";
+const char kAddress3[] = "0x3e02f254184E904300e0775E4b8eeCB3";
+const char kAddress4[] = "0x4e02f254184E904300e0775E4b8eeCB4";
+const char kAddress5[] = "0x5e02f254184E904300e0775E4b8eeCB5";
+const char kAddress6[] = "0x6e02f254184E904300e0775E4b8eeCB6";
+
+// Matches kBatchWindowMs in eth_json_rpc_controller.cc.
+constexpr base::TimeDelta kBatchWindow = base::TimeDelta::FromMilliseconds(20);
+
+// Response to a batch of two eth_getBalance calls and the trailing
+// eth_blockNumber.
+std::string BatchResponseAtBlock(const std::string& block_number) {
+  return R"([
+      {"jsonrpc": "2.0", "id": 0, "result": "0x1"},
+      {"jsonrpc": "2.0", "id": 1, "result": "0x2"},
+      {"jsonrpc": "2.0", "id": 2, "result": ")" +
+         block_number + R"("}
+    ])";
+}
+
+}  // namespace
+
 class EthJsonRpcControllerUnitTest : public testing::Test {
  public:
   EthJsonRpcControllerUnitTest()
-      : browser_context_(new content::TestBrowserContext()) {}
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        browser_context_(new content::TestBrowserContext()),
+        shared_url_loader_factory_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)) {
+    url_loader_factory_.SetInterceptor(
+        base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
+          request_bodies_.push_back(network::GetUploadData(request));
+        }));
+  }
   ~EthJsonRpcControllerUnitTest() override = default;
 
   content::TestBrowserContext* context() { return browser_context_.get(); }
 
- private:
+  std::unique_ptr<EthJsonRpcController> CreateController() {
+    auto controller = std::make_unique<EthJsonRpcController>(
+        shared_url_loader_factory_, Network::kMainnet);
+    controller->SetCustomNetwork(GURL(kNetworkURL));
+    return controller;
+  }
+
+  void GetBalance(EthJsonRpcController* controller,
+                  const std::string& address,
+                  std::string* balance) {
+    controller->GetBalance(
+        address, base::BindLambdaForTesting(
+                     [balance](bool success, const std::string& result) {
+                       EXPECT_TRUE(success);
+                       *balance = result;
+                     }));
+  }
+
+  // Sends whatever has been queued and returns the body of the request it
+  // produced, or an empty string if nothing went out.
+  std::string FlushRequest() {
+    request_bodies_.clear();
+    task_environment_.FastForwardBy(kBatchWindow);
+    EXPECT_LE(request_bodies_.size(), 1u);
+    return request_bodies_.empty() ? std::string() : request_bodies_.front();
+  }
+
+  void Respond(const std::string& body) {
+    EXPECT_TRUE(
+        url_loader_factory_.SimulateResponseForPendingRequest(kNetworkURL, body));
+    task_environment_.RunUntilIdle();
+  }
+
+  int NumPendingRequests() { return url_loader_factory_.NumPending(); }
+
+ protected:
   content::BrowserTaskEnvironment task_environment_;
+
+ private:
   std::unique_ptr<content::TestBrowserContext> browser_context_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  std::vector<std::string> request_bodies_;
 };
 
 TEST_F(EthJsonRpcControllerUnitTest, SetNetwork) {
@@ -72,4 +155,135 @@ TEST_F(EthJsonRpcControllerUnitTest, SetCustomNetwork) {
   ASSERT_EQ(controller.GetNetworkURL(), custom_network);
 }
 
+TEST_F(EthJsonRpcControllerUnitTest, BatchesCallsIssuedTogether) {
+  auto controller = CreateController();
+  std::string balance1;
+  std::string balance2;
+  GetBalance(controller.get(), kAddress1, &balance1);
+  GetBalance(controller.get(), kAddress2, &balance2);
+
+  base::Optional<base::Value> batch =
+      base::JSONReader::Read(FlushRequest());
+  ASSERT_TRUE(batch && batch->is_list());
+  ASSERT_EQ(batch->GetList().size(), 3u);
+  EXPECT_EQ(*batch->GetList()[0].FindStringKey("method"), "eth_getBalance");
+  EXPECT_EQ(*batch->GetList()[0].FindIntKey("id"), 0);
+  EXPECT_EQ(*batch->GetList()[1].FindStringKey("method"), "eth_getBalance");
+  EXPECT_EQ(*batch->GetList()[1].FindIntKey("id"), 1);
+  EXPECT_EQ(*batch->GetList()[2].FindStringKey("method"), "eth_blockNumber");
+  EXPECT_EQ(*batch->GetList()[2].FindIntKey("id"), 2);
+  EXPECT_EQ(NumPendingRequests(), 1);
+
+  // Responses are matched by id, not by position.
+  Respond(R"([
+      {"jsonrpc": "2.0", "id": 2, "result": "0x10"},
+      {"jsonrpc": "2.0", "id": 1, "result": "0x2"},
+      {"jsonrpc": "2.0", "id": 0, "result": "0x1"}
+    ])");
+  EXPECT_EQ(balance1, "0x1");
+  EXPECT_EQ(balance2, "0x2");
+}
+
+TEST_F(EthJsonRpcControllerUnitTest, SendsLoneCallUnbatched) {
+  auto controller = CreateController();
+  std::string balance;
+  GetBalance(controller.get(), kAddress1, &balance);
+
+  base::Optional<base::Value> call = base::JSONReader::Read(FlushRequest());
+  ASSERT_TRUE(call && call->is_dict());
+  EXPECT_EQ(*call->FindStringKey("method"), "eth_getBalance");
+
+  Respond(R"({"jsonrpc": "2.0", "id": 1, "result": "0x1"})");
+  EXPECT_EQ(balance, "0x1");
+}
+
+TEST_F(EthJsonRpcControllerUnitTest, CollapsesIdenticalCalls) {
+  auto controller = CreateController();
+  std::string balance1;
+  std::string balance2;
+  GetBalance(controller.get(), kAddress1, &balance1);
+  EXPECT_FALSE(FlushRequest().empty());
+
+  // Joins the call already in flight instead of sending another one.
+  GetBalance(controller.get(), kAddress1, &balance2);
+  EXPECT_TRUE(FlushRequest().empty());
+  EXPECT_EQ(NumPendingRequests(), 1);
+
+  Respond(R"({"jsonrpc": "2.0", "id": 1, "result": "0x1"})");
+  EXPECT_EQ(balance1, "0x1");
+  EXPECT_EQ(balance2, "0x1");
+}
+
+TEST_F(EthJsonRpcControllerUnitTest, CachesResultsUntilNewBlock) {
+  auto controller = CreateController();
+  std::string balance;
+  GetBalance(controller.get(), kAddress1, &balance);
+  GetBalance(controller.get(), kAddress2, &balance);
+  FlushRequest();
+  Respond(BatchResponseAtBlock("0x10"));
+
+  balance.clear();
+  GetBalance(controller.get(), kAddress1, &balance);
+  EXPECT_TRUE(FlushRequest().empty());
+  EXPECT_EQ(balance, "0x1");
+
+  // Another batch at the same block keeps the cache.
+  GetBalance(controller.get(), kAddress3, &balance);
+  GetBalance(controller.get(), kAddress4, &balance);
+  FlushRequest();
+  Respond(BatchResponseAtBlock("0x10"));
+  GetBalance(controller.get(), kAddress1, &balance);
+  EXPECT_TRUE(FlushRequest().empty());
+
+  // A new block drops it.
+  GetBalance(controller.get(), kAddress5, &balance);
+  GetBalance(controller.get(), kAddress6, &balance);
+  FlushRequest();
+  Respond(BatchResponseAtBlock("0x11"));
+  GetBalance(controller.get(), kAddress1, &balance);
+  EXPECT_FALSE(FlushRequest().empty());
+}
+
+TEST_F(EthJsonRpcControllerUnitTest, CachedResultsExpire) {
+  auto controller = CreateController();
+  std::string balance;
+  GetBalance(controller.get(), kAddress1, &balance);
+  FlushRequest();
+  Respond(R"({"jsonrpc": "2.0", "id": 1, "result": "0x1"})");
+
+  GetBalance(controller.get(), kAddress1, &balance);
+  EXPECT_TRUE(FlushRequest().empty());
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(15));
+  GetBalance(controller.get(), kAddress1, &balance);
+  EXPECT_FALSE(FlushRequest().empty());
+}
+
+TEST_F(EthJsonRpcControllerUnitTest, ChangingNetworkDropsCachedResults) {
+  auto controller = CreateController();
+  std::string balance;
+  GetBalance(controller.get(), kAddress1, &balance);
+  FlushRequest();
+  Respond(R"({"jsonrpc": "2.0", "id": 1, "result": "0x1"})");
+
+  controller->SetCustomNetwork(GURL(kNetworkURL));
+  GetBalance(controller.get(), kAddress1, &balance);
+  EXPECT_FALSE(FlushRequest().empty());
+}
+
+TEST_F(EthJsonRpcControllerUnitTest, DoesNotCacheErrors) {
+  auto controller = CreateController();
+  bool success = true;
+  auto callback = [&success](bool result, const std::string& balance) {
+    success = result;
+  };
+  controller->GetBalance(kAddress1, base::BindLambdaForTesting(callback));
+  FlushRequest();
+  Respond(R"({"jsonrpc": "2.0", "id": 1, "error": {"code": -32000}})");
+  EXPECT_FALSE(success);
+
+  controller->GetBalance(kAddress1, base::BindLambdaForTesting(callback));
+  EXPECT_FALSE(FlushRequest().empty());
+}
+
 }  // namespace brave_wallet
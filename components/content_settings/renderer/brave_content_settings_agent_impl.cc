@@ -103,6 +103,8 @@ void BraveContentSettingsAgentImpl::DidCommitProvisionalLoad(
     ui::PageTransition transition) {
   temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
+  cached_brave_shields_down_.reset();
+  cached_brave_farbling_level_.reset();
   ContentSettingsAgentImpl::DidCommitProvisionalLoad(transition);
 }
 
@@ -130,7 +132,7 @@ bool BraveContentSettingsAgentImpl::AllowScript(bool enabled_per_settings) {
   const GURL secondary_url(url::Origin(frame->GetSecurityOrigin()).GetURL());
 
   bool allow = ContentSettingsAgentImpl::AllowScript(enabled_per_settings);
-  allow = allow || IsBraveShieldsDown(frame, secondary_url) ||
+  allow = allow || IsBraveShieldsDownForDocument() ||
           IsScriptTemporilyAllowed(secondary_url);
 
   return allow;
@@ -245,13 +247,38 @@ bool BraveContentSettingsAgentImpl::IsBraveShieldsDown(
              frame, secondary_url, content_setting_rules_->brave_shields_rules);
 }
 
+bool BraveContentSettingsAgentImpl::IsBraveShieldsDownForDocument() {
+  MaybeInvalidateCachedBraveSettings();
+
+  if (!cached_brave_shields_down_) {
+    blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+    cached_brave_shields_down_ = IsBraveShieldsDown(
+        frame, url::Origin(frame->GetSecurityOrigin()).GetURL());
+  }
+
+  return *cached_brave_shields_down_;
+}
+
+void BraveContentSettingsAgentImpl::MaybeInvalidateCachedBraveSettings() {
+  const uint64_t content_setting_rules_version =
+      content_setting_rules_ ? content_setting_rules_->brave_rules_version : 0;
+
+  if (cached_content_setting_rules_ == content_setting_rules_ &&
+      cached_content_setting_rules_version_ == content_setting_rules_version) {
+    return;
+  }
+
+  cached_content_setting_rules_ = content_setting_rules_;
+  cached_content_setting_rules_version_ = content_setting_rules_version;
+  cached_brave_shields_down_.reset();
+  cached_brave_farbling_level_.reset();
+}
+
 bool BraveContentSettingsAgentImpl::AllowFingerprinting(
     bool enabled_per_settings) {
   if (!enabled_per_settings)
     return false;
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-  const GURL secondary_url(url::Origin(frame->GetSecurityOrigin()).GetURL());
-  if (IsBraveShieldsDown(frame, secondary_url)) {
+  if (IsBraveShieldsDownForDocument()) {
     return true;
   }
 
@@ -259,12 +286,20 @@ bool BraveContentSettingsAgentImpl::AllowFingerprinting(
 }
 
 BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
+  MaybeInvalidateCachedBraveSettings();
+
+  if (!cached_brave_farbling_level_)
+    cached_brave_farbling_level_ = ComputeBraveFarblingLevel();
+
+  return *cached_brave_farbling_level_;
+}
+
+BraveFarblingLevel BraveContentSettingsAgentImpl::ComputeBraveFarblingLevel() {
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
 
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
   if (content_setting_rules_) {
-    if (IsBraveShieldsDown(frame,
-                           url::Origin(frame->GetSecurityOrigin()).GetURL())) {
+    if (IsBraveShieldsDownForDocument()) {
       setting = CONTENT_SETTING_ALLOW;
     } else {
       setting = GetBraveFPContentSettingFromRules(
@@ -13,6 +13,7 @@
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
+#include "base/optional.h"
 #include "base/strings/string16.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "components/content_settings/core/common/content_settings.h"
@@ -62,6 +63,12 @@ class BraveContentSettingsAgentImpl : public ContentSettingsAgentImpl {
       const blink::WebFrame* frame,
       const GURL& secondary_url);
 
+  // Memoized for the committed document, see
+  // |MaybeInvalidateCachedBraveSettings|
+  bool IsBraveShieldsDownForDocument();
+  BraveFarblingLevel ComputeBraveFarblingLevel();
+  void MaybeInvalidateCachedBraveSettings();
+
   // RenderFrameObserver
   bool OnMessageReceived(const IPC::Message& message) override;
   void OnAllowScriptsOnce(const std::vector<std::string>& origins);
@@ -83,6 +90,15 @@ class BraveContentSettingsAgentImpl : public ContentSettingsAgentImpl {
   using StoragePermissionsKey = std::pair<url::Origin, StorageType>;
   base::flat_map<StoragePermissionsKey, bool> cached_storage_permissions_;
 
+  // Shields state and farbling level resolved for the committed document.
+  // Fingerprinting APIs query these on every call, so they are only resolved
+  // against the rules again after a new commit or when the browser sends new
+  // content setting rules
+  const RendererContentSettingRules* cached_content_setting_rules_ = nullptr;
+  uint64_t cached_content_setting_rules_version_ = 0;
+  base::Optional<bool> cached_brave_shields_down_;
+  base::Optional<BraveFarblingLevel> cached_brave_farbling_level_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveContentSettingsAgentImpl);
 };
 
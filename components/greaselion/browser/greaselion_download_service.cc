@@ -274,6 +274,7 @@ void GreaselionDownloadService::LoadDirectlyFromResourcePath() {
 void GreaselionDownloadService::OnDATFileDataReady(std::string contents) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   rules_.clear();
+  rules_version_++;
   if (contents.empty()) {
     LOG(ERROR) << "Could not obtain Greaselion configuration";
     return;
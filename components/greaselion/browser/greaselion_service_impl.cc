@@ -21,6 +21,8 @@
 #include "base/json/json_file_value_serializer.h"
 #include "base/one_shot_event.h"
 #include "base/sequenced_task_runner.h"
+#include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
@@ -186,6 +188,23 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   // the service exits
   return std::make_pair(extension, std::move(temp_dir));
 }
+
+// Identifies the extension converted from |rule|. Rules are named after their
+// position in the configuration file, so the key also covers everything that
+// goes into the converted extension and the version of the loaded rules.
+std::string GetRuleKey(const greaselion::GreaselionRule& rule,
+                       const int rules_version) {
+  std::vector<std::string> parts = {base::NumberToString(rules_version),
+                                    rule.name(), rule.run_at(),
+                                    rule.messages().AsUTF8Unsafe()};
+  for (const auto& url_pattern : rule.url_patterns())
+    parts.push_back(url_pattern);
+  for (const auto& script : rule.scripts())
+    parts.push_back(script.AsUTF8Unsafe());
+
+  return base::JoinString(parts, "\n");
+}
+
 }  // namespace
 
 namespace greaselion {
@@ -236,61 +255,93 @@ void GreaselionServiceImpl::UpdateInstalledExtensions() {
     return;
   }
   update_in_progress_ = true;
-  if (greaselion_extensions_.empty()) {
-    // No Greaselion extensions are currently installed, so we can move on to
-    // the install phase immediately.
+
+  // Only extensions for rules which no longer match, or which have changed,
+  // need to be unloaded. Everything else stays installed as is.
+  const std::map<std::string, const GreaselionRule*> rules =
+      GetMatchingRules();
+  for (auto iter = rule_extensions_.begin(); iter != rule_extensions_.end();) {
+    if (base::Contains(rules, iter->first)) {
+      ++iter;
+      continue;
+    }
+
+    extensions_pending_unload_.insert(iter->second);
+    iter = rule_extensions_.erase(iter);
+  }
+
+  if (extensions_pending_unload_.empty()) {
+    // Nothing to unload, so we can move on to the install phase immediately.
     CreateAndInstallExtensions();
     return;
   }
 
-  // Make a copy of greaselion_extensions_ to iterate while the original vector
-  // changes.
-  std::vector<extensions::ExtensionId> extensions = greaselion_extensions_;
-  for (auto id : extensions) {
-    // We need to unload all the Greaselion extensions that are already
-    // installed. OnExtensionUnloaded will be called on each extension, where we
-    // will update the greaselion_extensions_ set. Once it's empty, that
+  // Make a copy of extensions_pending_unload_ to iterate while the original
+  // set changes.
+  const std::set<extensions::ExtensionId> extensions =
+      extensions_pending_unload_;
+  for (const auto& id : extensions) {
+    // OnExtensionUnloaded will be called on each extension, where we will
+    // update the extensions_pending_unload_ set. Once it's empty, that
     // callback will call CreateAndInstallExtensions().
     extension_service_->UnloadExtension(
         id, extensions::UnloadedExtensionReason::UPDATE);
   }
 }
 
-void GreaselionServiceImpl::CreateAndInstallExtensions() {
-  DCHECK(greaselion_extensions_.empty());
-  DCHECK(update_in_progress_);
-  all_rules_installed_successfully_ = true;
-  pending_installs_ = 0;
+std::map<std::string, const GreaselionRule*>
+GreaselionServiceImpl::GetMatchingRules() {
+  std::map<std::string, const GreaselionRule*> matching_rules;
+
+  const int rules_version = download_service_->rules_version();
   std::vector<std::unique_ptr<GreaselionRule>>* rules =
       download_service_->rules();
   for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
     if (rule->Matches(state_, browser_version_) &&
         rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
+      matching_rules[GetRuleKey(*rule, rules_version)] = rule.get();
+    }
+  }
+
+  return matching_rules;
+}
+
+void GreaselionServiceImpl::CreateAndInstallExtensions() {
+  DCHECK(extensions_pending_unload_.empty());
+  DCHECK(update_in_progress_);
+  all_rules_installed_successfully_ = true;
+
+  std::map<std::string, const GreaselionRule*> rules = GetMatchingRules();
+  for (auto iter = rules.begin(); iter != rules.end();) {
+    if (base::Contains(rule_extensions_, iter->first)) {
+      // already installed
+      iter = rules.erase(iter);
+    } else {
+      ++iter;
     }
   }
+
+  pending_installs_ = static_cast<int>(rules.size());
   if (!pending_installs_) {
-    // no rules match, nothing else to do
+    // no new rules match, nothing else to do
     MaybeNotifyObservers();
     return;
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      GreaselionRule rule_copy(*rule);
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule_copy, install_directory_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
-    }
+  for (const auto& rule : rules) {
+    // Convert script file to component extension. This must run on extension
+    // file task runner, which was passed in in the constructor.
+    GreaselionRule rule_copy(*rule.second);
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
+                       rule_copy, install_directory_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr(), rule.first));
   }
 }
 
 void GreaselionServiceImpl::PostConvert(
+    const std::string& rule_key,
     base::Optional<GreaselionConvertedExtension> converted_extension) {
   if (!converted_extension) {
     all_rules_installed_successfully_ = false;
@@ -298,8 +349,10 @@ void GreaselionServiceImpl::PostConvert(
     MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
-    greaselion_extensions_.push_back(converted_extension->first->id());
-    extension_dirs_.push_back(std::move(converted_extension->second));
+    const extensions::ExtensionId id = converted_extension->first->id();
+    greaselion_extensions_.push_back(id);
+    rule_extensions_[rule_key] = id;
+    extension_dirs_[id] = std::move(converted_extension->second);
     extension_system_->ready().Post(
         FROM_HERE,
         base::BindOnce(&GreaselionServiceImpl::Install,
@@ -338,7 +391,30 @@ void GreaselionServiceImpl::OnExtensionUnloaded(
     return;
   }
   greaselion_extensions_.erase(index);
-  if (update_in_progress_ && greaselion_extensions_.empty()) {
+
+  // Keep |rule_extensions_| in sync if the extension was unloaded by someone
+  // else, so that it is installed again on the next update.
+  for (auto iter = rule_extensions_.begin(); iter != rule_extensions_.end();
+       ++iter) {
+    if (iter->second == extension->id()) {
+      rule_extensions_.erase(iter);
+      break;
+    }
+  }
+
+  auto extension_dir = extension_dirs_.find(extension->id());
+  if (extension_dir != extension_dirs_.end()) {
+    if (extension_dir->second.IsValid()) {
+      task_runner_->PostTask(
+          FROM_HERE,
+          base::BindOnce(base::IgnoreResult(&base::DeletePathRecursively),
+                         extension_dir->second.Take()));
+    }
+    extension_dirs_.erase(extension_dir);
+  }
+
+  if (extensions_pending_unload_.erase(extension->id()) &&
+      update_in_progress_ && extensions_pending_unload_.empty()) {
     // It's time!
     CreateAndInstallExtensions();
   }
@@ -8,6 +8,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -36,6 +37,7 @@ class ExtensionSystem;
 namespace greaselion {
 
 class GreaselionDownloadService;
+class GreaselionRule;
 
 class GreaselionServiceImpl : public GreaselionService {
  public:
@@ -68,8 +70,10 @@ class GreaselionServiceImpl : public GreaselionService {
 
  private:
   void SetBrowserVersionForTesting(const base::Version& version) override;
+  std::map<std::string, const GreaselionRule*> GetMatchingRules();
   void CreateAndInstallExtensions();
   void PostConvert(
+      const std::string& rule_key,
       base::Optional<GreaselionConvertedExtension> converted_extension);
   void Install(scoped_refptr<extensions::Extension> extension);
   void MaybeNotifyObservers();
@@ -87,7 +91,11 @@ class GreaselionServiceImpl : public GreaselionService {
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<Observer> observers_;
   std::vector<extensions::ExtensionId> greaselion_extensions_;
-  std::vector<base::ScopedTempDir> extension_dirs_;
+  // Installed extensions keyed by the rule they were converted from, so that
+  // rules which still match and haven't changed are not converted again
+  std::map<std::string, extensions::ExtensionId> rule_extensions_;
+  std::set<extensions::ExtensionId> extensions_pending_unload_;
+  std::map<extensions::ExtensionId, base::ScopedTempDir> extension_dirs_;
   base::Version browser_version_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 
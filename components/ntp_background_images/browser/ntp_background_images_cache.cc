@@ -0,0 +1,91 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_background_images_cache.h"
+
+#include <utility>
+
+#include "base/bind.h"
+
+namespace ntp_background_images {
+
+// static
+constexpr size_t NTPBackgroundImagesCache::kDefaultMaxBytes;
+
+NTPBackgroundImagesCache::NTPBackgroundImagesCache(size_t max_bytes)
+    : entries_(Entries::NO_AUTO_EVICT),
+      max_bytes_(max_bytes),
+      memory_pressure_listener_(new base::MemoryPressureListener(
+          FROM_HERE,
+          base::BindRepeating(&NTPBackgroundImagesCache::OnMemoryPressure,
+                              base::Unretained(this)))) {}
+
+NTPBackgroundImagesCache::~NTPBackgroundImagesCache() = default;
+
+scoped_refptr<base::RefCountedMemory> NTPBackgroundImagesCache::Get(
+    const base::FilePath& path) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto it = entries_.Get(path);
+  if (it == entries_.end()) {
+    ++miss_count_;
+    return nullptr;
+  }
+  ++hit_count_;
+  return it->second;
+}
+
+void NTPBackgroundImagesCache::Put(const base::FilePath& path,
+                                   scoped_refptr<base::RefCountedMemory> data) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(data);
+
+  auto it = entries_.Peek(path);
+  if (it != entries_.end()) {
+    size_in_bytes_ -= it->second->size();
+    entries_.Erase(it);
+  }
+
+  // Don't let one large file flush everything else.
+  if (data->size() > max_bytes_)
+    return;
+
+  while (!entries_.empty() && size_in_bytes_ + data->size() > max_bytes_) {
+    auto oldest = entries_.rbegin();
+    size_in_bytes_ -= oldest->second->size();
+    entries_.Erase(oldest);
+  }
+
+  size_in_bytes_ += data->size();
+  entries_.Put(path, std::move(data));
+}
+
+void NTPBackgroundImagesCache::ClearDirectory(const base::FilePath& dir) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (dir.IsParent(it->first)) {
+      size_in_bytes_ -= it->second->size();
+      it = entries_.Erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void NTPBackgroundImagesCache::Clear() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  entries_.Clear();
+  size_in_bytes_ = 0;
+}
+
+void NTPBackgroundImagesCache::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  if (memory_pressure_level ==
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE) {
+    return;
+  }
+  Clear();
+}
+
+}  // namespace ntp_background_images
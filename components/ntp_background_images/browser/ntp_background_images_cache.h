@@ -0,0 +1,69 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_CACHE_H_
+#define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_CACHE_H_
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/sequence_checker.h"
+
+namespace ntp_background_images {
+
+// Keeps recently served image files in memory so that opening a new tab does
+// not read the same wallpapers and logos from disk again. Entries are keyed by
+// absolute file path, which includes the component's versioned install
+// directory. The least recently used entries are dropped once |max_bytes| is
+// exceeded, and everything is dropped on memory pressure.
+class NTPBackgroundImagesCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 16 * 1024 * 1024;
+
+  explicit NTPBackgroundImagesCache(size_t max_bytes = kDefaultMaxBytes);
+  ~NTPBackgroundImagesCache();
+
+  NTPBackgroundImagesCache(const NTPBackgroundImagesCache&) = delete;
+  NTPBackgroundImagesCache& operator=(const NTPBackgroundImagesCache&) = delete;
+
+  // Returns nullptr if |path| is not cached.
+  scoped_refptr<base::RefCountedMemory> Get(const base::FilePath& path);
+  void Put(const base::FilePath& path,
+           scoped_refptr<base::RefCountedMemory> data);
+  // Drops the files under |dir|.
+  void ClearDirectory(const base::FilePath& dir);
+  void Clear();
+
+  size_t size_in_bytes() const { return size_in_bytes_; }
+  // Number of lookups served from memory, i.e. disk reads avoided.
+  size_t hit_count() const { return hit_count_; }
+  size_t miss_count() const { return miss_count_; }
+
+ private:
+  using Entries =
+      base::MRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>>;
+
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
+  Entries entries_;
+  const size_t max_bytes_;
+  size_t size_in_bytes_ = 0;
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace ntp_background_images
+
+#endif  // BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_CACHE_H_
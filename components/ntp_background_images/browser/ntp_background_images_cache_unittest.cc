@@ -0,0 +1,116 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_background_images_cache.h"
+
+#include <string>
+
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ntp_background_images {
+
+namespace {
+
+scoped_refptr<base::RefCountedMemory> MakeData(size_t size) {
+  std::string data(size, 'x');
+  return base::RefCountedString::TakeString(&data);
+}
+
+}  // namespace
+
+class NTPBackgroundImagesCacheTest : public testing::Test {
+ protected:
+  base::test::SingleThreadTaskEnvironment task_environment_;
+};
+
+TEST_F(NTPBackgroundImagesCacheTest, CountsHitsAndMisses) {
+  NTPBackgroundImagesCache cache;
+  const base::FilePath path(FILE_PATH_LITERAL("1.0.0/background-1.jpg"));
+
+  EXPECT_FALSE(cache.Get(path));
+  cache.Put(path, MakeData(10));
+  EXPECT_TRUE(cache.Get(path));
+  EXPECT_TRUE(cache.Get(path));
+
+  EXPECT_EQ(2u, cache.hit_count());
+  EXPECT_EQ(1u, cache.miss_count());
+  EXPECT_EQ(10u, cache.size_in_bytes());
+}
+
+TEST_F(NTPBackgroundImagesCacheTest, KeyedByVersionedPath) {
+  NTPBackgroundImagesCache cache;
+  cache.Put(base::FilePath(FILE_PATH_LITERAL("1.0.0/background-1.jpg")),
+            MakeData(10));
+  EXPECT_FALSE(
+      cache.Get(base::FilePath(FILE_PATH_LITERAL("1.0.1/background-1.jpg"))));
+}
+
+TEST_F(NTPBackgroundImagesCacheTest, EvictsLeastRecentlyUsed) {
+  NTPBackgroundImagesCache cache(25);
+  const base::FilePath first(FILE_PATH_LITERAL("first.jpg"));
+  const base::FilePath second(FILE_PATH_LITERAL("second.jpg"));
+  const base::FilePath third(FILE_PATH_LITERAL("third.jpg"));
+
+  cache.Put(first, MakeData(10));
+  cache.Put(second, MakeData(10));
+  // Touch |first| so that |second| is the oldest one.
+  EXPECT_TRUE(cache.Get(first));
+  cache.Put(third, MakeData(10));
+
+  EXPECT_TRUE(cache.Get(first));
+  EXPECT_FALSE(cache.Get(second));
+  EXPECT_TRUE(cache.Get(third));
+  EXPECT_EQ(20u, cache.size_in_bytes());
+
+  // Replacing an entry doesn't count it twice.
+  cache.Put(third, MakeData(5));
+  EXPECT_EQ(15u, cache.size_in_bytes());
+
+  // Files larger than the cache are not kept.
+  cache.Put(second, MakeData(30));
+  EXPECT_FALSE(cache.Get(second));
+  EXPECT_EQ(15u, cache.size_in_bytes());
+}
+
+TEST_F(NTPBackgroundImagesCacheTest, Clear) {
+  NTPBackgroundImagesCache cache;
+  const base::FilePath path(FILE_PATH_LITERAL("background-1.jpg"));
+  cache.Put(path, MakeData(10));
+  cache.Clear();
+  EXPECT_EQ(0u, cache.size_in_bytes());
+  EXPECT_FALSE(cache.Get(path));
+}
+
+TEST_F(NTPBackgroundImagesCacheTest, ClearDirectory) {
+  NTPBackgroundImagesCache cache;
+  const base::FilePath old_path(FILE_PATH_LITERAL("1.0.0/background-1.jpg"));
+  const base::FilePath new_path(FILE_PATH_LITERAL("1.0.1/background-1.jpg"));
+  cache.Put(old_path, MakeData(10));
+  cache.Put(new_path, MakeData(5));
+
+  cache.ClearDirectory(base::FilePath(FILE_PATH_LITERAL("1.0.0")));
+  EXPECT_EQ(5u, cache.size_in_bytes());
+  EXPECT_FALSE(cache.Get(old_path));
+  EXPECT_TRUE(cache.Get(new_path));
+}
+
+TEST_F(NTPBackgroundImagesCacheTest, ClearsOnMemoryPressure) {
+  NTPBackgroundImagesCache cache;
+  const base::FilePath path(FILE_PATH_LITERAL("background-1.jpg"));
+  cache.Put(path, MakeData(10));
+
+  base::MemoryPressureListener::SimulatePressureNotification(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  base::RunLoop().RunUntilIdle();
+
+  EXPECT_EQ(0u, cache.size_in_bytes());
+  EXPECT_FALSE(cache.Get(path));
+}
+
+}  // namespace ntp_background_images
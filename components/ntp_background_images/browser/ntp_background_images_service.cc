@@ -421,13 +421,20 @@ NTPBackgroundImagesService::GetBackgroundImagesData(bool super_referral) const {
   return nullptr;
 }
 
+bool NTPBackgroundImagesService::IsCurrentImageFile(
+    const base::FilePath& path) const {
+  return si_installed_dir_.IsParent(path) || sr_installed_dir_.IsParent(path);
+}
+
 void NTPBackgroundImagesService::OnComponentReady(
     bool is_super_referral,
     const base::FilePath& installed_dir) {
-  if (is_super_referral)
-    sr_installed_dir_ = installed_dir;
-  else
-    si_installed_dir_ = installed_dir;
+  base::FilePath& current_dir =
+      is_super_referral ? sr_installed_dir_ : si_installed_dir_;
+  // Files of the replaced component version won't be requested again.
+  if (!current_dir.empty() && current_dir != installed_dir)
+    image_cache_.ClearDirectory(current_dir);
+  current_dir = installed_dir;
 
   DVLOG(2) << __func__ << (is_super_referral ? ": NPT SR Component is ready"
                                              : ": NTP SI Component is ready");
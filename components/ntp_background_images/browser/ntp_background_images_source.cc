@@ -24,11 +24,12 @@ namespace ntp_background_images {
 
 namespace {
 
-base::Optional<std::string> ReadFileToString(const base::FilePath& path) {
+scoped_refptr<base::RefCountedMemory> ReadFileToBytes(
+    const base::FilePath& path) {
   std::string contents;
   if (!base::ReadFileToString(path, &contents))
-    return base::Optional<std::string>();
-  return contents;
+    return nullptr;
+  return base::RefCountedString::TakeString(&contents);
 }
 
 bool IsSuperReferralPath(const std::string& path) {
@@ -98,24 +99,27 @@ void NTPBackgroundImagesSource::StartDataRequest(
 void NTPBackgroundImagesSource::GetImageFile(
     const base::FilePath& image_file_path,
     GotDataCallback callback) {
+  if (auto bytes = service_->image_cache()->Get(image_file_path)) {
+    std::move(callback).Run(std::move(bytes));
+    return;
+  }
+
   base::PostTaskAndReplyWithResult(
       FROM_HERE, {base::ThreadPool(), base::MayBlock()},
-      base::BindOnce(&ReadFileToString, image_file_path),
+      base::BindOnce(&ReadFileToBytes, image_file_path),
       base::BindOnce(&NTPBackgroundImagesSource::OnGotImageFile,
-                     weak_factory_.GetWeakPtr(),
+                     weak_factory_.GetWeakPtr(), image_file_path,
                      std::move(callback)));
 }
 
 void NTPBackgroundImagesSource::OnGotImageFile(
+    const base::FilePath& image_file_path,
     GotDataCallback callback,
-    base::Optional<std::string> input) {
-  if (!input)
-    return;
-
-  scoped_refptr<base::RefCountedMemory> bytes;
-  bytes = new base::RefCountedBytes(
-       reinterpret_cast<const unsigned char*>(input->c_str()), input->length());
-  std::move(callback).Run(std::move(bytes));
+    scoped_refptr<base::RefCountedMemory> data) {
+  // The component may have been updated while the file was read.
+  if (data && service_->IsCurrentImageFile(image_file_path))
+    service_->image_cache()->Put(image_file_path, data);
+  std::move(callback).Run(std::move(data));
 }
 
 std::string NTPBackgroundImagesSource::GetMimeType(const std::string& path) {
@@ -125,7 +129,10 @@ std::string NTPBackgroundImagesSource::GetMimeType(const std::string& path) {
 }
 
 bool NTPBackgroundImagesSource::AllowCaching() {
-  return false;
+  // Image URLs stay the same across component updates, so no freshness
+  // lifetime is sent. A page reuses what it loaded, and the next new tab page
+  // asks again and is served from |image_cache()|.
+  return true;
 }
 
 bool NTPBackgroundImagesSource::IsValidPath(const std::string& path) const {
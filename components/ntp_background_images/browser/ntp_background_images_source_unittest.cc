@@ -6,6 +6,11 @@
 #include <memory>
 #include <string>
 
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/run_loop.h"
 #include "base/test/task_environment.h"
 #include "brave/components/brave_referrals/browser/brave_referrals_service.h"
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
@@ -32,7 +37,7 @@ class NTPBackgroundImagesSourceTest : public testing::Test {
                     base::Value(base::Value::Type::DICTIONARY));
   }
 
-  base::test::SingleThreadTaskEnvironment task_environment;
+  base::test::TaskEnvironment task_environment;
   TestingPrefServiceSimple local_pref_;
   std::unique_ptr<NTPBackgroundImagesService> service_;
   std::unique_ptr<NTPBackgroundImagesSource> source_;
@@ -63,7 +68,7 @@ TEST_F(NTPBackgroundImagesSourceTest, BasicTest) {
         ]
       })";
   service_->OnGetComponentJsonData(false, test_json_string_referral);
-  EXPECT_FALSE(source_->AllowCaching());
+  EXPECT_TRUE(source_->AllowCaching());
   EXPECT_TRUE(source_->IsWallpaperPath("sponsored-images/wallpaper-1.jpg"));
   EXPECT_FALSE(source_->IsValidPath("super-duper/brave.png"));
   EXPECT_FALSE(source_->IsValidPath("sponsored-images/abcd.png"));
@@ -78,6 +83,78 @@ TEST_F(NTPBackgroundImagesSourceTest, BasicTest) {
       source_->GetWallpaperIndexFromPath("sponsored-images/wallpaper-3.jpg"));
 }
 
+TEST_F(NTPBackgroundImagesSourceTest, CachesImageFiles) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath image_file_path =
+      temp_dir.GetPath().AppendASCII("background-1.jpg");
+  const std::string image_data = "wallpaper";
+  ASSERT_EQ(static_cast<int>(image_data.size()),
+            base::WriteFile(image_file_path, image_data.data(),
+                            image_data.size()));
+
+  const std::string test_json_string = R"(
+      {
+        "schemaVersion": 1,
+        "wallpapers": [
+          {
+            "imageUrl": "background-1.jpg"
+          }
+        ]
+      })";
+  service_->si_installed_dir_ = temp_dir.GetPath();
+  service_->OnGetComponentJsonData(false, test_json_string);
+
+  auto get_image_file = [this, &image_file_path]() {
+    std::string result;
+    base::RunLoop run_loop;
+    source_->GetImageFile(
+        image_file_path,
+        base::BindOnce(
+            [](std::string* result, base::OnceClosure quit,
+               scoped_refptr<base::RefCountedMemory> bytes) {
+              if (bytes)
+                result->assign(bytes->front_as<char>(), bytes->size());
+              std::move(quit).Run();
+            },
+            &result, run_loop.QuitClosure()));
+    run_loop.Run();
+    return result;
+  };
+
+  auto* cache = service_->image_cache();
+  EXPECT_EQ(image_data, get_image_file());
+  EXPECT_EQ(0u, cache->hit_count());
+  EXPECT_EQ(1u, cache->miss_count());
+  EXPECT_EQ(image_data.size(), cache->size_in_bytes());
+
+  // Served from memory without reading the file again.
+  ASSERT_TRUE(base::DeleteFile(image_file_path));
+  EXPECT_EQ(image_data, get_image_file());
+  EXPECT_EQ(1u, cache->hit_count());
+  EXPECT_EQ(1u, cache->miss_count());
+
+  // Reloading the same component version keeps the cached files.
+  service_->OnComponentReady(false, temp_dir.GetPath());
+  task_environment.RunUntilIdle();
+  EXPECT_EQ(image_data.size(), cache->size_in_bytes());
+
+  // A component update drops the files of the replaced version.
+  base::ScopedTempDir new_temp_dir;
+  ASSERT_TRUE(new_temp_dir.CreateUniqueTempDir());
+  service_->OnComponentReady(false, new_temp_dir.GetPath());
+  task_environment.RunUntilIdle();
+  EXPECT_EQ(0u, cache->size_in_bytes());
+
+  // Files of the replaced version are no longer cached once read.
+  ASSERT_EQ(static_cast<int>(image_data.size()),
+            base::WriteFile(image_file_path, image_data.data(),
+                            image_data.size()));
+  EXPECT_EQ(image_data, get_image_file());
+  EXPECT_EQ(2u, cache->miss_count());
+  EXPECT_EQ(0u, cache->size_in_bytes());
+}
+
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
 
 #if !defined(OS_LINUX)
@@ -125,7 +202,7 @@ TEST_F(NTPBackgroundImagesSourceTest, BasicSuperReferralDataTest) {
         ]
       })";
   service_->OnGetComponentJsonData(true, test_json_string_referral);
-  EXPECT_FALSE(source_->AllowCaching());
+  EXPECT_TRUE(source_->AllowCaching());
   EXPECT_TRUE(source_->IsTopSiteFaviconPath("super-referral/bat.png"));
   EXPECT_FALSE(source_->IsTopSiteFaviconPath("super-referral/logo.png"));
   EXPECT_TRUE(source_->IsWallpaperPath("super-referral/wallpaper-1.jpg"));
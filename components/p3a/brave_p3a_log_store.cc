@@ -10,6 +10,7 @@
 #include "base/rand_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/values.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
@@ -51,6 +52,33 @@ void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
 
 void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
                                    uint64_t value) {
+  DictionaryPrefUpdate update(local_state_, kPrefName);
+  UpdateValueImpl(histogram_name, value, update.Get());
+}
+
+void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
+  DictionaryPrefUpdate update(local_state_, kPrefName);
+  RemoveValueIfExistsImpl(histogram_name, update.Get());
+}
+
+void BraveP3ALogStore::UpdateValues(const std::vector<ValueUpdate>& updates) {
+  if (updates.empty()) {
+    return;
+  }
+
+  DictionaryPrefUpdate update(local_state_, kPrefName);
+  for (const auto& value_update : updates) {
+    if (value_update.second) {
+      UpdateValueImpl(value_update.first, *value_update.second, update.Get());
+    } else {
+      RemoveValueIfExistsImpl(value_update.first, update.Get());
+    }
+  }
+}
+
+void BraveP3ALogStore::UpdateValueImpl(const std::string& histogram_name,
+                                       uint64_t value,
+                                       base::DictionaryValue* persisted_log) {
   LogEntry& entry = log_[histogram_name];
   entry.value = value;
   if (!entry.sent) {
@@ -59,20 +87,21 @@ void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
   }
 
   // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  persisted_log->SetPath({histogram_name, kLogValueKey},
+                         base::Value(base::NumberToString(value)));
+  persisted_log->SetPath({histogram_name, kLogSentKey},
+                         base::Value(entry.sent));
 }
 
-void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
+void BraveP3ALogStore::RemoveValueIfExistsImpl(
+    const std::string& histogram_name,
+    base::DictionaryValue* persisted_log) {
   DCHECK(delegate_->IsActualMetric(histogram_name));
   log_.erase(histogram_name);
   unsent_entries_.erase(histogram_name);
 
   // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->RemovePath(histogram_name);
+  persisted_log->RemovePath(histogram_name);
 
   if (has_staged_log() && staged_entry_key_ == histogram_name) {
     staged_entry_key_.clear();
@@ -7,16 +7,23 @@
 #define BRAVE_COMPONENTS_P3A_BRAVE_P3A_LOG_STORE_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/strings/string_piece.h"
+#include "base/optional.h"
 #include "base/time/time.h"
 #include "components/metrics/log_store.h"
 
 class PrefService;
 class PrefRegistrySimple;
 
+namespace base {
+class DictionaryValue;
+}  // namespace base
+
 namespace brave {
 
 // Stores all given values in memory and persists in prefs on the fly.
@@ -46,6 +53,12 @@ class BraveP3ALogStore : public metrics::LogStore {
   void UpdateValue(const std::string& histogram_name, uint64_t value);
   // Removes and also unstages the metric value if it is known and/or staged.
   void RemoveValueIfExists(const std::string& histogram_name);
+
+  // A new value for a histogram, or nullopt to remove it.
+  using ValueUpdate = std::pair<std::string, base::Optional<uint64_t>>;
+  // Applies the updates in order, as UpdateValue() or RemoveValueIfExists()
+  // would, but persists them with a single prefs update.
+  void UpdateValues(const std::vector<ValueUpdate>& updates);
   // Marks all saved values as unsent.
   void ResetUploadStamps();
 
@@ -84,6 +97,12 @@ class BraveP3ALogStore : public metrics::LogStore {
     base::Time sent_timestamp;  // At the moment only for debugging purposes.
   };
 
+  void UpdateValueImpl(const std::string& histogram_name,
+                       uint64_t value,
+                       base::DictionaryValue* persisted_log);
+  void RemoveValueIfExistsImpl(const std::string& histogram_name,
+                               base::DictionaryValue* persisted_log);
+
   Delegate* const delegate_ = nullptr;  // Weak.
   PrefService* const local_state_ = nullptr;
 
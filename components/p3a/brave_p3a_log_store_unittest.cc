@@ -0,0 +1,95 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/p3a/brave_p3a_log_store.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=P3ALogStore*
+
+namespace brave {
+
+namespace {
+
+class TestDelegate : public BraveP3ALogStore::Delegate {
+ public:
+  std::string Serialize(base::StringPiece histogram_name,
+                        uint64_t value) override {
+    return histogram_name.as_string() + ":" + base::NumberToString(value);
+  }
+
+  bool IsActualMetric(base::StringPiece histogram_name) const override {
+    return true;
+  }
+};
+
+}  // namespace
+
+class P3ALogStoreTest : public testing::Test {
+ public:
+  P3ALogStoreTest() {
+    BraveP3ALogStore::RegisterPrefs(local_state_.registry());
+    log_store_ = std::make_unique<BraveP3ALogStore>(&delegate_, &local_state_);
+    log_store_->LoadPersistedUnsentLogs();
+  }
+
+ protected:
+  // Stages every unsent entry and returns them in staging order.
+  std::vector<std::string> StageAll() {
+    std::vector<std::string> logs;
+    while (log_store_->has_unsent_logs()) {
+      log_store_->StageNextLog();
+      logs.push_back(log_store_->staged_log());
+      log_store_->DiscardStagedLog();
+    }
+    std::sort(logs.begin(), logs.end());
+    return logs;
+  }
+
+  TestingPrefServiceSimple local_state_;
+  TestDelegate delegate_;
+  std::unique_ptr<BraveP3ALogStore> log_store_;
+};
+
+TEST_F(P3ALogStoreTest, UpdateValuesAppliesInOrder) {
+  log_store_->UpdateValues({{"Brave.A", 1}, {"Brave.B", 2}, {"Brave.A", 3}});
+
+  EXPECT_EQ(StageAll(), (std::vector<std::string>{"Brave.A:3", "Brave.B:2"}));
+}
+
+TEST_F(P3ALogStoreTest, UpdateValuesRemovesSuspendedMetrics) {
+  log_store_->UpdateValue("Brave.A", 1);
+  log_store_->UpdateValue("Brave.B", 2);
+  log_store_->StageNextLog();
+
+  log_store_->UpdateValues({{"Brave.A", base::nullopt},
+                            {"Brave.B", base::nullopt},
+                            {"Brave.B", 4}});
+
+  EXPECT_FALSE(log_store_->has_staged_log());
+  EXPECT_EQ(StageAll(), (std::vector<std::string>{"Brave.B:4"}));
+}
+
+TEST_F(P3ALogStoreTest, UpdateValuesPersists) {
+  log_store_->UpdateValues({{"Brave.A", 1}, {"Brave.B", 2}});
+  log_store_->UpdateValues({{"Brave.B", base::nullopt}});
+
+  BraveP3ALogStore reloaded(&delegate_, &local_state_);
+  reloaded.LoadPersistedUnsentLogs();
+  ASSERT_TRUE(reloaded.has_unsent_logs());
+  reloaded.StageNextLog();
+  EXPECT_EQ(reloaded.staged_log(), "Brave.A:1");
+  reloaded.DiscardStagedLog();
+  EXPECT_FALSE(reloaded.has_unsent_logs());
+}
+
+}  // namespace brave
@@ -0,0 +1,52 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_pending_values.h"
+
+#include <limits>
+
+#include "base/check_op.h"
+
+namespace brave {
+
+namespace {
+
+constexpr uint64_t kNoPendingValue = std::numeric_limits<uint64_t>::max();
+
+}  // namespace
+
+BraveP3APendingValues::BraveP3APendingValues(size_t size)
+    : size_(size), buckets_(new std::atomic<uint64_t>[size]) {
+  for (size_t i = 0; i < size_; i++) {
+    buckets_[i].store(kNoPendingValue, std::memory_order_relaxed);
+  }
+}
+
+BraveP3APendingValues::~BraveP3APendingValues() = default;
+
+bool BraveP3APendingValues::Record(size_t index, uint64_t bucket) {
+  DCHECK_LT(index, size_);
+  DCHECK_NE(bucket, kNoPendingValue);
+  buckets_[index].store(bucket, std::memory_order_release);
+  return !has_pending_.exchange(true, std::memory_order_acq_rel);
+}
+
+std::vector<std::pair<size_t, uint64_t>> BraveP3APendingValues::TakeAll() {
+  // Cleared first, so a value recorded while we collect asks for another
+  // TakeAll() rather than getting lost.
+  has_pending_.store(false, std::memory_order_release);
+
+  std::vector<std::pair<size_t, uint64_t>> values;
+  for (size_t i = 0; i < size_; i++) {
+    const uint64_t bucket =
+        buckets_[i].exchange(kNoPendingValue, std::memory_order_acq_rel);
+    if (bucket != kNoPendingValue) {
+      values.emplace_back(i, bucket);
+    }
+  }
+  return values;
+}
+
+}  // namespace brave
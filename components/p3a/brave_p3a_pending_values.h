@@ -0,0 +1,46 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_P3A_BRAVE_P3A_PENDING_VALUES_H_
+#define BRAVE_COMPONENTS_P3A_BRAVE_P3A_PENDING_VALUES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace brave {
+
+// Keeps the latest bucket recorded for each collected histogram until the
+// service writes them to the log store, so that a burst of samples costs one
+// log update. Record() may be called on any thread and does not lock.
+class BraveP3APendingValues {
+ public:
+  explicit BraveP3APendingValues(size_t size);
+  ~BraveP3APendingValues();
+
+  BraveP3APendingValues(const BraveP3APendingValues&) = delete;
+  BraveP3APendingValues& operator=(const BraveP3APendingValues&) = delete;
+
+  // Replaces any pending bucket for |index|. Returns true if nothing else was
+  // pending since the last TakeAll(), i.e. the caller should schedule one.
+  bool Record(size_t index, uint64_t bucket);
+
+  // Returns the pending (index, bucket) pairs ordered by index and forgets
+  // them.
+  std::vector<std::pair<size_t, uint64_t>> TakeAll();
+
+ private:
+  const size_t size_;
+  std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+  std::atomic<bool> has_pending_{false};
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMPONENTS_P3A_BRAVE_P3A_PENDING_VALUES_H_
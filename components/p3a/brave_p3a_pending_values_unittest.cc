@@ -0,0 +1,59 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/p3a/brave_p3a_pending_values.h"
+
+#include <limits.h>
+#include <stdint.h>
+
+#include <utility>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=P3APendingValues*
+
+namespace brave {
+
+namespace {
+using PendingValues = std::vector<std::pair<size_t, uint64_t>>;
+}  // namespace
+
+TEST(P3APendingValuesTest, LatestValueWins) {
+  BraveP3APendingValues pending_values(4);
+
+  EXPECT_TRUE(pending_values.Record(2, 1));
+  EXPECT_FALSE(pending_values.Record(0, 3));
+  EXPECT_FALSE(pending_values.Record(2, 5));
+
+  EXPECT_EQ(pending_values.TakeAll(), (PendingValues{{0, 3}, {2, 5}}));
+  EXPECT_TRUE(pending_values.TakeAll().empty());
+}
+
+TEST(P3APendingValuesTest, AsksForDrainAfterTakeAll) {
+  BraveP3APendingValues pending_values(2);
+  EXPECT_TRUE(pending_values.TakeAll().empty());
+
+  EXPECT_TRUE(pending_values.Record(1, 1));
+  pending_values.TakeAll();
+  EXPECT_TRUE(pending_values.Record(1, 2));
+  EXPECT_EQ(pending_values.TakeAll(), (PendingValues{{1, 2}}));
+}
+
+TEST(P3APendingValuesTest, SuspendedValueReplacesBucket) {
+  constexpr uint64_t kSuspendedMetricBucket = INT_MAX - 1;
+  BraveP3APendingValues pending_values(1);
+
+  pending_values.Record(0, 4);
+  pending_values.Record(0, kSuspendedMetricBucket);
+  EXPECT_EQ(pending_values.TakeAll(),
+            (PendingValues{{0, kSuspendedMetricBucket}}));
+
+  pending_values.Record(0, kSuspendedMetricBucket);
+  pending_values.Record(0, 4);
+  EXPECT_EQ(pending_values.TakeAll(), (PendingValues{{0, 4}}));
+}
+
+}  // namespace brave
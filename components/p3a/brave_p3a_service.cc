@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/i18n/timezone.h"
@@ -17,6 +18,7 @@
 #include "base/metrics/statistics_recorder.h"
 #include "base/no_destructor.h"
 #include "base/rand_util.h"
+#include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/task/post_task.h"
 #include "base/trace_event/trace_event.h"
@@ -56,6 +58,10 @@ constexpr char kP2AServerUrl[] = "https://p2a.brave.com/";
 
 constexpr uint64_t kDefaultUploadIntervalSeconds = 60;  // 1 minute.
 
+// Samples recorded within this window are written to the log together.
+constexpr base::TimeDelta kDrainPendingValuesDelay =
+    base::TimeDelta::FromSeconds(1);
+
 // TODO(iefremov): Provide moar histograms!
 // Whitelist for histograms that we collect. Will be replaced with something
 // updating on the fly.
@@ -194,7 +200,9 @@ base::TimeDelta TimeDeltaTillMonday(base::Time time) {
 }  // namespace
 
 BraveP3AService::BraveP3AService(PrefService* local_state)
-    : local_state_(local_state) {}
+    : local_state_(local_state),
+      pending_values_(base::size(kCollectedHistograms)),
+      histograms_(base::size(kCollectedHistograms)) {}
 
 BraveP3AService::~BraveP3AService() = default;
 
@@ -209,10 +217,10 @@ void BraveP3AService::RegisterPrefs(PrefRegistrySimple* registry,
 }
 
 void BraveP3AService::InitCallbacks() {
-  for (const char* histogram_name : kCollectedHistograms) {
+  for (size_t i = 0; i < base::size(kCollectedHistograms); i++) {
     base::StatisticsRecorder::SetCallback(
-        histogram_name,
-        base::BindRepeating(&BraveP3AService::OnHistogramChanged, this));
+        kCollectedHistograms[i],
+        base::BindRepeating(&BraveP3AService::OnHistogramChanged, this, i));
   }
 }
 
@@ -240,10 +248,7 @@ void BraveP3AService::Init(
   log_store_.reset(new BraveP3ALogStore(this, local_state_));
   log_store_->LoadPersistedUnsentLogs();
   // Store values that were recorded between calling constructor and |Init()|.
-  for (const auto& entry : histogram_values_) {
-    HandleHistogramChange(entry.first.as_string(), entry.second);
-  }
-  histogram_values_ = {};
+  DrainPendingValues();
   // Do rotation if needed.
   const base::Time last_rotation =
       local_state_->GetTime(kLastRotationTimeStampPref);
@@ -374,6 +379,8 @@ void BraveP3AService::UpdatePyxisMeta() {
 
 void BraveP3AService::StartScheduledUpload() {
   VLOG(2) << "BraveP3AService::StartScheduledUpload at " << base::Time::Now();
+  // Make sure the log reflects the latest samples before staging from it.
+  DrainPendingValues();
   if (!log_store_->has_unsent_logs()) {
     // We continue to schedule next uploads since new histogram values can
     // come up at any moment. Maybe it's worth to add a method with more
@@ -398,75 +405,77 @@ void BraveP3AService::StartScheduledUpload() {
   }
 }
 
-void BraveP3AService::OnHistogramChanged(const char* histogram_name,
+void BraveP3AService::OnHistogramChanged(size_t histogram_index,
+                                         const char* histogram_name,
                                          uint64_t name_hash,
                                          base::HistogramBase::Sample sample) {
-  std::unique_ptr<base::HistogramSamples> samples =
-      base::StatisticsRecorder::FindHistogram(histogram_name)->SnapshotDelta();
+  // Histograms live as long as the process, so the pointer can be reused.
+  base::HistogramBase* histogram =
+      histograms_[histogram_index].load(std::memory_order_acquire);
+  if (!histogram) {
+    histogram = base::StatisticsRecorder::FindHistogram(histogram_name);
+    histograms_[histogram_index].store(histogram, std::memory_order_release);
+  }
+  std::unique_ptr<base::HistogramSamples> samples = histogram->SnapshotDelta();
   DCHECK(!samples->Iterator()->Done());
 
   // Shortcut for the special values, see |kSuspendedMetricValue|
   // description for details.
-  if (IsSuspendedMetric(histogram_name, sample)) {
-    base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                   base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI,
-                                  this,
-                                  histogram_name,
-                                  kSuspendedMetricValue,
-                                  kSuspendedMetricBucket));
-    return;
-  }
+  uint64_t bucket = kSuspendedMetricBucket;
+  if (!IsSuspendedMetric(histogram_name, sample)) {
+    // Note that we store only buckets, not actual values.
+    size_t bucket_index = 0u;
+    const bool ok = samples->Iterator()->GetBucketIndex(&bucket_index);
+    if (!ok) {
+      LOG(ERROR) << "Only linear histograms are supported at the moment!";
+      NOTREACHED();
+      return;
+    }
 
-  // Note that we store only buckets, not actual values.
-  size_t bucket = 0u;
-  const bool ok = samples->Iterator()->GetBucketIndex(&bucket);
-  if (!ok) {
-    LOG(ERROR) << "Only linear histograms are supported at the moment!";
-    NOTREACHED();
-    return;
+    // Special handling of P2A histograms.
+    if (base::StartsWith(histogram_name, "Brave.P2A.",
+                         base::CompareCase::SENSITIVE)) {
+      // We need the bucket count to make proper perturbation.
+      // All P2A metrics should be implemented as linear histograms.
+      base::SampleVector* vector =
+          static_cast<base::SampleVector*>(samples.get());
+      DCHECK(vector);
+      const size_t bucket_count = vector->bucket_ranges()->bucket_count() - 1;
+      VLOG(2) << "P2A metric " << histogram_name << " has bucket count "
+              << bucket_count;
+
+      // Perturb the bucket.
+      bucket_index = DirectEncodingProtocol::Perturb(bucket_count, bucket_index);
+    }
+    bucket = bucket_index;
   }
 
-  // Special handling of P2A histograms.
-  if (base::StartsWith(histogram_name, "Brave.P2A.",
-                       base::CompareCase::SENSITIVE)) {
-    // We need the bucket count to make proper perturbation.
-    // All P2A metrics should be implemented as linear histograms.
-    base::SampleVector* vector =
-        static_cast<base::SampleVector*>(samples.get());
-    DCHECK(vector);
-    const size_t bucket_count = vector->bucket_ranges()->bucket_count() - 1;
-    VLOG(2) << "P2A metric " << histogram_name << " has bucket count "
-            << bucket_count;
-
-    // Perturb the bucket.
-    bucket = DirectEncodingProtocol::Perturb(bucket_count, bucket);
+  VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
+          << histogram_name << " Sample = " << sample << " bucket = " << bucket;
+  if (pending_values_.Record(histogram_index, bucket)) {
+    base::PostDelayedTask(
+        FROM_HERE, {content::BrowserThread::UI},
+        base::BindOnce(&BraveP3AService::DrainPendingValues, this),
+        kDrainPendingValuesDelay);
   }
-
-  base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                 base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI, this,
-                                histogram_name, sample, bucket));
 }
 
-void BraveP3AService::OnHistogramChangedOnUI(const char* histogram_name,
-                                             base::HistogramBase::Sample sample,
-                                             size_t bucket) {
-  VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
-          << histogram_name << " Sample = " << sample << " bucket = " << bucket;
+void BraveP3AService::DrainPendingValues() {
   if (!initialized_) {
     // Will handle it later when ready.
-    histogram_values_[histogram_name] = bucket;
-  } else {
-    HandleHistogramChange(histogram_name, bucket);
+    return;
   }
-}
 
-void BraveP3AService::HandleHistogramChange(base::StringPiece histogram_name,
-                                            size_t bucket) {
-  if (IsSuspendedMetric(histogram_name, bucket)) {
-    log_store_->RemoveValueIfExists(histogram_name.as_string());
-    return;
+  std::vector<BraveP3ALogStore::ValueUpdate> updates;
+  for (const auto& pending_value : pending_values_.TakeAll()) {
+    const char* histogram_name = kCollectedHistograms[pending_value.first];
+    if (IsSuspendedMetric(histogram_name, pending_value.second)) {
+      updates.emplace_back(histogram_name, base::nullopt);
+    } else {
+      updates.emplace_back(histogram_name, pending_value.second);
+    }
   }
-  log_store_->UpdateValue(histogram_name.as_string(), bucket);
+  log_store_->UpdateValues(updates);
 }
 
 void BraveP3AService::OnLogUploadComplete(int response_code,
@@ -6,15 +6,17 @@
 #ifndef BRAVE_COMPONENTS_P3A_BRAVE_P3A_SERVICE_H_
 #define BRAVE_COMPONENTS_P3A_BRAVE_P3A_SERVICE_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
-#include "base/containers/flat_map.h"
 #include "base/memory/ref_counted.h"
 #include "base/metrics/histogram_base.h"
 #include "base/timer/timer.h"
 #include "brave/components/brave_prochlo/brave_prochlo_message.h"
 #include "brave/components/p3a/brave_p3a_log_store.h"
+#include "brave/components/p3a/brave_p3a_pending_values.h"
 #include "url/gurl.h"
 
 class PrefRegistrySimple;
@@ -68,17 +70,15 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void StartScheduledUpload();
 
   // Invoked by callbacks registered by our service. Since these callbacks
-  // can fire on any thread, this method reposts everything to UI thread.
-  void OnHistogramChanged(const char* histogram_name,
+  // can fire on any thread, this method only records the bucket in
+  // |pending_values_| and schedules a drain on the UI thread.
+  void OnHistogramChanged(size_t histogram_index,
+                          const char* histogram_name,
                           uint64_t name_hash,
                           base::HistogramBase::Sample sample);
 
-  void OnHistogramChangedOnUI(const char* histogram_name,
-                              base::HistogramBase::Sample sample,
-                              size_t bucket);
-
-  // Updates or removes a metric from the log.
-  void HandleHistogramChange(base::StringPiece histogram_name, size_t bucket);
+  // Updates or removes the metrics recorded since the last drain in the log.
+  void DrainPendingValues();
 
   void OnLogUploadComplete(int response_code, int error_code, bool was_https);
 
@@ -105,9 +105,14 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   std::unique_ptr<BraveP3AUploader> uploader_;
   std::unique_ptr<BraveP3AScheduler> upload_scheduler_;
 
-  // Used to store histogram values that are produced between constructing
-  // the service and its initialization.
-  base::flat_map<base::StringPiece, size_t> histogram_values_;
+  // Buckets recorded since the last drain, indexed like the collected
+  // histograms list. Values produced between constructing the service and its
+  // initialization also wait here.
+  BraveP3APendingValues pending_values_;
+
+  // Collected histograms seen so far, so that recording a sample doesn't need
+  // to look them up in the StatisticsRecorder.
+  std::vector<std::atomic<base::HistogramBase*>> histograms_;
 
   // Once fired we restart the overall uploading process.
   base::OneShotTimer rotation_timer_;
@@ -142,23 +142,30 @@ void BatAdsClientMojoBridge::Save(
       std::move(callback)));
 }
 
-void OnLoadUserModelForId(
-    const ads::LoadCallback& callback,
-    const int32_t result,
-    const std::string& value) {
-  callback(ToAdsResult(result), value);
-}
-
 void BatAdsClientMojoBridge::LoadUserModelForId(
     const std::string& id,
     ads::LoadCallback callback) {
+  // User models are passed as files, see |LoadUserModelFileForId|
+  NOTREACHED();
+  callback(ads::Result::FAILED, "");
+}
+
+void OnLoadUserModelFileForId(
+    const ads::LoadFileCallback& callback,
+    base::File file) {
+  callback(std::move(file));
+}
+
+void BatAdsClientMojoBridge::LoadUserModelFileForId(
+    const std::string& id,
+    ads::LoadFileCallback callback) {
   if (!connected()) {
-    callback(ads::Result::FAILED, "");
+    callback(base::File());
     return;
   }
 
-  bat_ads_client_->LoadUserModelForId(id,
-      base::BindOnce(&OnLoadUserModelForId, std::move(callback)));
+  bat_ads_client_->LoadUserModelFileForId(id,
+      base::BindOnce(&OnLoadUserModelFileForId, std::move(callback)));
 }
 
 void BatAdsClientMojoBridge::RecordP2AEvent(
@@ -52,6 +52,9 @@ class BatAdsClientMojoBridge
   void LoadUserModelForId(
       const std::string& id,
       ads::LoadCallback callback) override;
+  void LoadUserModelFileForId(
+      const std::string& id,
+      ads::LoadFileCallback callback) override;
 
   void RecordP2AEvent(
       const std::string& name,
@@ -100,27 +100,26 @@ void AdsClientMojoBridge::Log(
 }
 
 // static
-void AdsClientMojoBridge::OnLoadUserModelForId(
-    CallbackHolder<LoadCallback>* holder,
-    const ads::Result result,
-    const std::string& value) {
+void AdsClientMojoBridge::OnLoadUserModelFileForId(
+    CallbackHolder<LoadUserModelFileForIdCallback>* holder,
+    base::File file) {
   DCHECK(holder);
 
   if (holder->is_valid()) {
-    std::move(holder->get()).Run((int32_t)result, std::move(value));
+    std::move(holder->get()).Run(std::move(file));
   }
 
   delete holder;
 }
 
-void AdsClientMojoBridge::LoadUserModelForId(
+void AdsClientMojoBridge::LoadUserModelFileForId(
     const std::string& id,
-    LoadCallback callback) {
-  // this gets deleted in OnLoad
-  auto* holder =
-      new CallbackHolder<LoadCallback>(AsWeakPtr(), std::move(callback));
-  ads_client_->LoadUserModelForId(
-      id, std::bind(AdsClientMojoBridge::OnLoadUserModelForId, holder, _1, _2));
+    LoadUserModelFileForIdCallback callback) {
+  // this gets deleted in OnLoadUserModelFileForId
+  auto* holder = new CallbackHolder<LoadUserModelFileForIdCallback>(
+      AsWeakPtr(), std::move(callback));
+  ads_client_->LoadUserModelFileForId(
+      id, std::bind(AdsClientMojoBridge::OnLoadUserModelFileForId, holder, _1));
 }
 
 void AdsClientMojoBridge::RecordP2AEvent(
@@ -58,9 +58,9 @@ class AdsClientMojoBridge
       const int32_t line,
       const int32_t verbose_level,
       const std::string& message) override;
-  void LoadUserModelForId(
+  void LoadUserModelFileForId(
       const std::string& id,
-      LoadCallback callback) override;
+      LoadUserModelFileForIdCallback callback) override;
 
   void RecordP2AEvent(
       const std::string& name,
@@ -151,10 +151,9 @@ class AdsClientMojoBridge
     Callback callback_;
   };
 
-  static void OnLoadUserModelForId(
-      CallbackHolder<LoadCallback>* holder,
-      const ads::Result result,
-      const std::string& value);
+  static void OnLoadUserModelFileForId(
+      CallbackHolder<LoadUserModelFileForIdCallback>* holder,
+      base::File file);
 
   static void OnLoad(
       CallbackHolder<LoadCallback>* holder,
@@ -11,15 +11,25 @@
 #include <vector>
 
 #include "base/logging.h"
+#include "base/time/time.h"
 
 namespace bat_ledger {
 
+namespace {
+
+const size_t kMaxPendingLogEntries = 100;
+const int kLogFlushIntervalInMilliseconds = 500;
+
+}  // namespace
+
 BatLedgerClientMojoBridge::BatLedgerClientMojoBridge(
       mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info) {
   bat_ledger_client_.Bind(std::move(client_info));
 }
 
-BatLedgerClientMojoBridge::~BatLedgerClientMojoBridge() = default;
+BatLedgerClientMojoBridge::~BatLedgerClientMojoBridge() {
+  FlushLog();
+}
 
 void OnLoadURL(
     const ledger::client::LoadURLCallback& callback,
@@ -56,7 +66,46 @@ void BatLedgerClientMojoBridge::Log(
     return;
   }
 
-  bat_ledger_client_->Log(file, line, verbose_level, message);
+  auto entry = mojom::LogEntry::New();
+  entry->time = base::Time::Now();
+  entry->file = file;
+  entry->line = line;
+  entry->verbose_level = verbose_level;
+  entry->message = message;
+  pending_log_entries_.push_back(std::move(entry));
+
+  // Errors are sent straight away so they are not lost if the utility process
+  // goes away before the next flush
+  if (verbose_level == 0 ||
+      pending_log_entries_.size() >= kMaxPendingLogEntries) {
+    FlushLog();
+    return;
+  }
+
+  if (log_flush_timer_.IsRunning()) {
+    return;
+  }
+
+  log_flush_timer_.Start(FROM_HERE,
+      base::TimeDelta::FromMilliseconds(kLogFlushIntervalInMilliseconds),
+      this, &BatLedgerClientMojoBridge::FlushLog);
+}
+
+void BatLedgerClientMojoBridge::FlushLog() {
+  log_flush_timer_.Stop();
+
+  if (pending_log_entries_.empty()) {
+    return;
+  }
+
+  std::vector<mojom::LogEntryPtr> entries;
+  entries.swap(pending_log_entries_);
+
+  if (!Connected()) {
+    return;
+  }
+
+  bat_ledger_client_->Log(std::move(entries));
 }
 
 void BatLedgerClientMojoBridge::OnLoadLedgerState(
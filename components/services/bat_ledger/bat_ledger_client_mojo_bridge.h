@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
+#include "base/timer/timer.h"
 #include "bat/ledger/ledger_client.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
@@ -127,7 +128,12 @@ class BatLedgerClientMojoBridge :
  private:
   bool Connected() const;
 
+  void FlushLog();
+
   mojo::AssociatedRemote<mojom::BatLedgerClient> bat_ledger_client_;
+
+  std::vector<mojom::LogEntryPtr> pending_log_entries_;
+  base::OneShotTimer log_flush_timer_;
 };
 
 }  // namespace bat_ledger
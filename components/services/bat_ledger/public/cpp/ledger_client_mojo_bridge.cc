@@ -14,9 +14,12 @@ using std::placeholders::_3;
 namespace bat_ledger {
 
 LedgerClientMojoBridge::LedgerClientMojoBridge(
-    ledger::LedgerClient* ledger_client)
-  : ledger_client_(ledger_client) {
+    ledger::LedgerClient* ledger_client,
+    LogCallback log_callback)
+  : ledger_client_(ledger_client),
+    log_callback_(std::move(log_callback)) {
   DCHECK(ledger_client_);
+  DCHECK(log_callback_);
 }
 
 LedgerClientMojoBridge::~LedgerClientMojoBridge() = default;
@@ -338,12 +341,11 @@ void LedgerClientMojoBridge::PendingContributionSaved(
   ledger_client_->PendingContributionSaved(result);
 }
 
-void LedgerClientMojoBridge::Log(
-    const std::string& file,
-    const int32_t line,
-    const int32_t verbose_level,
-    const std::string& message) {
-  ledger_client_->Log(file.c_str(), line, verbose_level, message);
+void LedgerClientMojoBridge::Log(std::vector<mojom::LogEntryPtr> entries) {
+  for (const auto& entry : entries) {
+    log_callback_.Run(entry->time, entry->file, entry->line,
+        entry->verbose_level, entry->message);
+  }
 }
 
 void LedgerClientMojoBridge::ClearAllNotifications() {
@@ -12,7 +12,9 @@
 #include <utility>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "bat/ledger/ledger_client.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 
@@ -22,7 +24,16 @@ class LedgerClientMojoBridge :
     public mojom::BatLedgerClient,
     public base::SupportsWeakPtr<LedgerClientMojoBridge> {
  public:
-  explicit LedgerClientMojoBridge(ledger::LedgerClient* ledger_client);
+  // Receives log entries together with the time they were logged, as they
+  // are batched in the utility process before they are sent
+  using LogCallback = base::RepeatingCallback<void(const base::Time& time,
+                                                   const std::string& file,
+                                                   const int line,
+                                                   const int verbose_level,
+                                                   const std::string& message)>;
+
+  LedgerClientMojoBridge(ledger::LedgerClient* ledger_client,
+                         LogCallback log_callback);
   ~LedgerClientMojoBridge() override;
 
   LedgerClientMojoBridge(const LedgerClientMojoBridge&) = delete;
@@ -121,11 +132,7 @@ class LedgerClientMojoBridge :
 
   void PendingContributionSaved(const ledger::type::Result result) override;
 
-  void Log(
-      const std::string& file,
-      const int32_t line,
-      const int32_t verbose_level,
-      const std::string& message) override;
+  void Log(std::vector<mojom::LogEntryPtr> entries) override;
 
   void ClearAllNotifications() override;
 
@@ -197,6 +204,7 @@ class LedgerClientMojoBridge :
       const ledger::type::Result result);
 
   ledger::LedgerClient* ledger_client_;
+  LogCallback log_callback_;
 };
 
 }  // namespace bat_ledger
@@ -0,0 +1,75 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_distiller.h"
+
+#include <utility>
+
+#include "base/metrics/histogram_macros.h"
+#include "base/strings/string_util.h"
+#include "brave/components/speedreader/rust/ffi/speedreader.h"
+#include "url/gurl.h"
+
+namespace speedreader {
+
+SpeedreaderDistiller::SpeedreaderDistiller(SpeedReader* speedreader,
+                                           const GURL& url,
+                                           const std::string& stylesheet)
+    : output_(stylesheet),
+      stylesheet_size_(output_.size()),
+      rewriter_(speedreader->MakeRewriter(url.spec(),
+                                          RewriterType::RewriterUnknown,
+                                          &SpeedreaderDistiller::OnOutput,
+                                          this)) {}
+
+SpeedreaderDistiller::~SpeedreaderDistiller() = default;
+
+void SpeedreaderDistiller::Write(std::string chunk) {
+  if (rewriter_) {
+    const base::TimeTicks start = base::TimeTicks::Now();
+    const bool accepted = rewriter_->Write(chunk.data(), chunk.length()) == 0;
+    distill_time_ += base::TimeTicks::Now() - start;
+    if (!accepted)
+      Reject();
+  }
+  body_chunks_.push_back(std::move(chunk));
+}
+
+std::string SpeedreaderDistiller::Finish() {
+  if (rewriter_) {
+    const base::TimeTicks start = base::TimeTicks::Now();
+    const bool accepted = rewriter_->End() == 0;
+    distill_time_ += base::TimeTicks::Now() - start;
+    // Covers the whole page, not just the tail handled by End().
+    UMA_HISTOGRAM_TIMES("Brave.Speedreader.Distill", distill_time_);
+
+    // TODO(brave-browser/issues/10372): would be better to pass explicit
+    // signal back from rewriter to indicate if content was found
+    if (!accepted || output_.length() - stylesheet_size_ < 1024)
+      Reject();
+  }
+
+  if (!rewriter_)
+    return base::JoinString(body_chunks_, "");
+
+  body_chunks_.clear();
+  return std::move(output_);
+}
+
+// static
+void SpeedreaderDistiller::OnOutput(const char* chunk,
+                                    size_t chunk_len,
+                                    void* user_data) {
+  static_cast<SpeedreaderDistiller*>(user_data)->output_.append(chunk,
+                                                                chunk_len);
+}
+
+void SpeedreaderDistiller::Reject() {
+  rewriter_.reset();
+  output_.clear();
+  output_.shrink_to_fit();
+}
+
+}  // namespace speedreader
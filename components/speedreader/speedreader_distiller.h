@@ -0,0 +1,63 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_DISTILLER_H_
+#define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_DISTILLER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/time/time.h"
+
+class GURL;
+
+namespace speedreader {
+
+class Rewriter;
+class SpeedReader;
+
+// Streams a response body through a rewriter as it is received, so most of
+// the distilling is done by the time the last chunk arrives. The distiller
+// owns the received chunks, so the page can still be sent untouched if the
+// rewriter rejects it, without the caller keeping a second copy of the body.
+// Not thread safe; must be used and destroyed on a single sequence after
+// construction.
+class SpeedreaderDistiller {
+ public:
+  SpeedreaderDistiller(SpeedReader* speedreader,
+                       const GURL& url,
+                       const std::string& stylesheet);
+  ~SpeedreaderDistiller();
+
+  SpeedreaderDistiller(const SpeedreaderDistiller&) = delete;
+  SpeedreaderDistiller& operator=(const SpeedreaderDistiller&) = delete;
+
+  // Feeds the next chunk of the body to the rewriter. Once the rewriter has
+  // rejected the page, chunks are only kept for the fallback.
+  void Write(std::string chunk);
+
+  // Returns the stylesheet followed by the distilled page, or the original
+  // body if the page could not be distilled.
+  std::string Finish();
+
+ private:
+  static void OnOutput(const char* chunk, size_t chunk_len, void* user_data);
+
+  // Drops the rewriter and anything it has written so far.
+  void Reject();
+
+  std::string output_;
+  const size_t stylesheet_size_;
+  std::vector<std::string> body_chunks_;
+  // Reset once the rewriter rejects the page.
+  std::unique_ptr<Rewriter> rewriter_;
+  // Time spent in the rewriter over all chunks.
+  base::TimeDelta distill_time_;
+};
+
+}  // namespace speedreader
+
+#endif  // BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_DISTILLER_H_
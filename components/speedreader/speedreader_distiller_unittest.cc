@@ -0,0 +1,97 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_distiller.h"
+
+#include <cstring>
+#include <string>
+
+#include "brave/components/speedreader/rust/ffi/speedreader.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+constexpr char kTestConfig[] = R"(
+[
+    {
+        "domain": "example.com",
+        "url_rules": [
+            "||example.com/*/article/"
+        ],
+        "declarative_rewrite": {
+            "main_content": [
+                ".article-body"
+            ],
+            "main_content_cleanup": [],
+            "delazify": false,
+            "fix_embeds": false,
+            "content_script": null,
+            "preprocess": []
+        }
+    }
+]
+)";
+
+constexpr char kArticleURL[] =
+    "https://example.com/news/article/topic/index.html";
+constexpr char kStylesheet[] = "<style id=\"brave_speedreader_style\"></style>";
+
+// Long enough for the distilled page to be kept.
+std::string MakeArticle() {
+  return "<html><div class=\"article-body\">" + std::string(4096, 'a') +
+         "</div></html>";
+}
+
+}  // namespace
+
+namespace speedreader {
+
+class SpeedreaderDistillerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(speedreader_.deserialize(kTestConfig, strlen(kTestConfig)));
+  }
+
+  SpeedReader speedreader_;
+};
+
+TEST_F(SpeedreaderDistillerTest, ChunkedInput) {
+  const std::string article = MakeArticle();
+  SpeedreaderDistiller distiller(&speedreader_, GURL(kArticleURL),
+                                 kStylesheet);
+  // Uneven chunks, including ones that split tags.
+  size_t offset = 0;
+  for (size_t chunk_size : {7u, 1u, 100u, 1024u}) {
+    distiller.Write(article.substr(offset, chunk_size));
+    offset += chunk_size;
+  }
+  distiller.Write(article.substr(offset));
+
+  EXPECT_EQ(kStylesheet + article, distiller.Finish());
+}
+
+TEST_F(SpeedreaderDistillerTest, MidStreamFailureFallsBackToOriginalBody) {
+  const std::string head = "<html><div class=\"article-body\">";
+  const std::string ambiguity =
+      "<select><div><style><div></div></style></div></select>";
+  const std::string tail = std::string(4096, 'a') + "</div></html>";
+  SpeedreaderDistiller distiller(&speedreader_, GURL(kArticleURL),
+                                 kStylesheet);
+  distiller.Write(head);
+  distiller.Write(ambiguity);
+  // Chunks after the failure must still make it into the fallback.
+  distiller.Write(tail);
+
+  EXPECT_EQ(head + ambiguity + tail, distiller.Finish());
+}
+
+TEST_F(SpeedreaderDistillerTest, EmptyBody) {
+  SpeedreaderDistiller distiller(&speedreader_, GURL(kArticleURL),
+                                 kStylesheet);
+  EXPECT_EQ("", distiller.Finish());
+}
+
+}  // namespace speedreader
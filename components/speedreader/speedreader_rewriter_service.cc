@@ -92,6 +92,10 @@ std::unique_ptr<Rewriter> SpeedreaderRewriterService::MakeRewriter(
   return speedreader_->MakeRewriter(url.spec());
 }
 
+SpeedReader* SpeedreaderRewriterService::GetSpeedReader() {
+  return speedreader_.get();
+}
+
 const std::string& SpeedreaderRewriterService::GetContentStylesheet() {
   return content_stylesheet_;
 }
@@ -44,6 +44,7 @@ class SpeedreaderRewriterService : public SpeedreaderComponent::Observer {
   // The API
   bool IsWhitelisted(const GURL& url);
   std::unique_ptr<Rewriter> MakeRewriter(const GURL& url);
+  SpeedReader* GetSpeedReader();
   const std::string& GetContentStylesheet();
 
  private:
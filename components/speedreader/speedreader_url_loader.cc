@@ -5,14 +5,16 @@
 
 #include "brave/components/speedreader/speedreader_url_loader.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 
 #include "base/bind.h"
-#include "base/metrics/histogram_macros.h"
+#include "base/sequenced_task_runner.h"
 #include "base/task/post_task.h"
-#include "brave/components/speedreader/rust/ffi/speedreader.h"
+#include "base/task_runner_util.h"
+#include "brave/components/speedreader/speedreader_distiller.h"
 #include "brave/components/speedreader/speedreader_rewriter_service.h"
 #include "brave/components/speedreader/speedreader_throttle.h"
 #include "mojo/public/cpp/bindings/self_owned_receiver.h"
@@ -62,6 +64,9 @@ SpeedReaderURLLoader::SpeedReaderURLLoader(
       destination_url_loader_client_(std::move(destination_url_loader_client)),
       response_url_(response_url),
       task_runner_(task_runner),
+      distill_task_runner_(base::CreateSequencedTaskRunner(
+          {base::ThreadPool(), base::TaskPriority::USER_BLOCKING})),
+      distiller_(nullptr, base::OnTaskRunnerDeleter(distill_task_runner_)),
       body_consumer_watcher_(FROM_HERE,
                              mojo::SimpleWatcher::ArmingPolicy::MANUAL,
                              task_runner),
@@ -118,6 +123,11 @@ void SpeedReaderURLLoader::OnStartLoadingResponseBody(
     mojo::ScopedDataPipeConsumerHandle body) {
   VLOG(2) << __func__ << " " << response_url_;
   state_ = State::kLoading;
+  if (throttle_ && rewriter_service_) {
+    distiller_.reset(new SpeedreaderDistiller(
+        rewriter_service_->GetSpeedReader(), response_url_,
+        rewriter_service_->GetContentStylesheet()));
+  }
   body_consumer_handle_ = std::move(body);
   body_consumer_watcher_.Watch(
       body_consumer_handle_.get(),
@@ -190,17 +200,15 @@ void SpeedReaderURLLoader::ResumeReadingBodyFromNet() {
 void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
   DCHECK_EQ(State::kLoading, state_);
 
-  size_t start_size = buffered_body_.size();
-  uint32_t read_bytes = kReadBufferSize;
-  buffered_body_.resize(start_size + read_bytes);
-  MojoResult result = body_consumer_handle_->ReadData(
-      &buffered_body_[0] + start_size, &read_bytes, MOJO_READ_DATA_FLAG_NONE);
+  const void* buffer = nullptr;
+  uint32_t read_bytes = 0;
+  MojoResult result = body_consumer_handle_->BeginReadData(
+      &buffer, &read_bytes, MOJO_READ_DATA_FLAG_NONE);
   switch (result) {
     case MOJO_RESULT_OK:
       break;
     case MOJO_RESULT_FAILED_PRECONDITION:
       // Reading is finished.
-      buffered_body_.resize(start_size);
       MaybeLaunchSpeedreader();
       return;
     case MOJO_RESULT_SHOULD_WAIT:
@@ -212,11 +220,23 @@ void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
   }
 
   DCHECK_EQ(MOJO_RESULT_OK, result);
-  buffered_body_.resize(start_size + read_bytes);
-  // TODO(iefremov): We actually can partially |pumpContent| to speedreader,
-  // but skipping it for now to simplify things. Pumping is not free in terms
-  // of CPU ticks, so we will have to keep alive speedreader instance on another
-  // thread.
+  // Keeps each chunk handed to the distiller bounded.
+  read_bytes = std::min(read_bytes, kReadBufferSize);
+  const char* chunk = static_cast<const char*>(buffer);
+  body_size_ += read_bytes;
+  if (distiller_) {
+    // The distiller takes ownership of the chunk, so the body is only held
+    // once. |distiller_| is deleted on |distill_task_runner_|, after any task
+    // posted here.
+    distill_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&SpeedreaderDistiller::Write,
+                       base::Unretained(distiller_.get()),
+                       std::string(chunk, read_bytes)));
+  } else {
+    buffered_body_.append(chunk, read_bytes);
+  }
+  body_consumer_handle_->EndReadData(read_bytes);
 
   body_consumer_watcher_.ArmOrNotify();
 }
@@ -237,45 +257,27 @@ void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
     return;
   }
 
-  VLOG(2) << __func__ << " buffered body size = " << buffered_body_.size();
-  bytes_remaining_in_buffer_ = buffered_body_.size();
+  VLOG(2) << __func__ << " body size = " << body_size_;
 
-  if (bytes_remaining_in_buffer_ > 0) {
-    // Offload heavy distilling to another thread.
+  if (body_size_ > 0 && distiller_) {
+    // Only the tail of the page is left to distill, so this stays on the
+    // distiller's sequence rather than holding up the loader.
     base::PostTaskAndReplyWithResult(
-        FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
-        base::BindOnce(
-            [](std::string data, std::unique_ptr<Rewriter> rewriter,
-               const std::string& stylesheet) -> auto {
-              SCOPED_UMA_HISTOGRAM_TIMER("Brave.Speedreader.Distill");
-              int written = rewriter->Write(data.c_str(), data.length());
-              // Error occurred
-              if (written != 0) {
-                return data;
-              }
-
-              rewriter->End();
-              const std::string& transformed = rewriter->GetOutput();
-
-              // TODO(brave-browser/issues/10372): would be better to pass
-              // explicit signal back from rewriter to indicate if content was
-              // found
-              if (transformed.length() < 1024) {
-                return data;
-              }
-
-              return stylesheet + transformed;
-            },
-            std::move(buffered_body_),
-            rewriter_service_->MakeRewriter(response_url_),
-            rewriter_service_->GetContentStylesheet()),
-        base::BindOnce(&SpeedReaderURLLoader::CompleteLoading,
+        distill_task_runner_.get(), FROM_HERE,
+        base::BindOnce(&SpeedreaderDistiller::Finish,
+                       base::Unretained(distiller_.get())),
+        base::BindOnce(&SpeedReaderURLLoader::OnDistillFinished,
                        weak_factory_.GetWeakPtr()));
     return;
   }
   CompleteLoading(std::move(buffered_body_));
 }
 
+void SpeedReaderURLLoader::OnDistillFinished(std::string body) {
+  distiller_.reset();
+  CompleteLoading(std::move(body));
+}
+
 void SpeedReaderURLLoader::CompleteLoading(std::string body) {
   DCHECK_EQ(State::kLoading, state_);
   state_ = State::kSending;
@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 #define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -13,6 +14,8 @@
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+#include "base/sequenced_task_runner.h"
 #include "base/strings/string_piece.h"
 #include "mojo/public/cpp/bindings/binding.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
@@ -27,6 +30,7 @@
 namespace speedreader {
 
 class SpeedReaderThrottle;
+class SpeedreaderDistiller;
 class SpeedreaderRewriterService;
 
 // Loads the whole response body and tries to Speedreader-distill it.
@@ -38,9 +42,11 @@ class SpeedreaderRewriterService;
 //               finished (= OnComplete() is called). When body is provided, the
 //               state is changed to kLoading. Otherwise the state goes to
 //               kCompleted.
-// kLoading: Receives the body from the source loader and distills the page.
-//            The received body is kept in this loader until distilling
-//            is finished. When all body has been received and distilling is
+// kLoading: Receives the body from the source loader and feeds each chunk to
+//            the rewriter on a thread pool sequence as it arrives. The
+//            received body is handed over to the distiller rather than
+//            kept in this loader, and is given back if the rewriter
+//            rejects the page. When all body has been received and distilling is
 //            done, this loader will dispatch queued messages like
 //            OnStartLoadingResponseBody() to the destination
 //            loader client, and then the state is changed to kSending.
@@ -113,6 +119,7 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   void OnBodyReadable(MojoResult);
   void OnBodyWritable(MojoResult);
   void MaybeLaunchSpeedreader();
+  void OnDistillFinished(std::string body);
 
   // Gets either distilled or untouched body.
   void CompleteLoading(std::string body);
@@ -138,10 +145,18 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   // Set if OnComplete() is called during distilling.
   base::Optional<network::URLLoaderCompletionStatus> complete_status_;
 
-  // Note that this could be replaced by a distilled version.
+  // While loading, only used when there is no distiller. Holds either the
+  // distilled or the untouched body while sending.
   std::string buffered_body_;
   size_t bytes_remaining_in_buffer_;
 
+  // Total size of the body received from the source loader.
+  size_t body_size_ = 0;
+
+  // Owns the rewriter and the received body on |distill_task_runner_|.
+  scoped_refptr<base::SequencedTaskRunner> distill_task_runner_;
+  std::unique_ptr<SpeedreaderDistiller, base::OnTaskRunnerDeleter> distiller_;
+
   mojo::ScopedDataPipeConsumerHandle body_consumer_handle_;
   mojo::ScopedDataPipeProducerHandle body_producer_handle_;
   mojo::SimpleWatcher body_consumer_watcher_;
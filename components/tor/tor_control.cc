@@ -5,6 +5,9 @@
 
 #include "brave/components/tor/tor_control.h"
 
+#include <string.h>
+
+#include "base/callback_helpers.h"
 #include "base/sequenced_task_runner.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
@@ -83,7 +86,6 @@ TorControl::TorControl(TorControl::Delegate* delegate,
       writing_(false),
       reading_(false),
       read_start_(-1),
-      read_cr_(false),
       delegate_(delegate) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(owner_sequence_checker_);
   DETACH_FROM_SEQUENCE(io_sequence_checker_);
@@ -642,40 +644,45 @@ void TorControl::ReadDone(int rv) {
     Error();
     return;
   }
-  const char* data = readiobuf_->data();
-  for (int i = 0; i < rv; i++) {
-    if (!read_cr_) {
-      // No CR yet.  Accept CR or non-LF; reject LF.
-      if (data[i] == 0x0d) {  // CR
-        read_cr_ = true;
-      } else if (data[i] == 0x0a) {  // LF
-        VLOG(1) << "tor: stray line feed";
-        Error();
-        return;
-      } else {
-        // Anything else: Just accept it and move on.
-      }
-    } else {
-      // CR seen.  Accept LF; reject all else.
-      if (data[i] == 0x0a) {  // LF
-        // CRLF seen, so we must have i >= 2.  Emit a line and advance
-        // to the next one, unless anything went wrong with the line.
-        assert(i >= 1);
-        std::string line(readiobuf_->StartOfBuffer() + read_start_,
-                         readiobuf_->offset() + i - 1 - read_start_);
-        read_start_ = readiobuf_->offset() + i + 1;
-        read_cr_ = false;
-        if (!ReadLine(line)) {
-          reading_ = false;
-          return;
-        }
-      } else {
-        // CR seen, but not LF.  Bad.
-        VLOG(1) << "tor: stray carriage return";
-        Error();
-        return;
-      }
+  // Hand whatever this read produced to the delegate in one task, however
+  // we leave this function.
+  base::ScopedClosureRunner flush_notifications(base::BindOnce(
+      &TorControl::FlushNotifications, weak_ptr_factory_.GetWeakPtr()));
+
+  // Split the input into CRLF-terminated lines.  Lines always start at
+  // read_start_; the new input ends at offset() + rv.
+  const char* const buffer = readiobuf_->StartOfBuffer();
+  const char* const end = readiobuf_->data() + rv;
+  const char* search = readiobuf_->data();
+  while (const char* lf = static_cast<const char*>(
+             memchr(search, 0x0a, end - search))) {  // LF
+    const char* const start = buffer + read_start_;
+    // A line must end with CR and contain no other CR.
+    if (lf == start || lf[-1] != 0x0d) {  // CR
+      VLOG(1) << "tor: stray line feed";
+      Error();
+      return;
+    }
+    if (memchr(start, 0x0d, lf - 1 - start)) {
+      VLOG(1) << "tor: stray carriage return";
+      Error();
+      return;
     }
+    const base::StringPiece line(start, lf - 1 - start);
+    read_start_ = lf + 1 - buffer;
+    search = lf + 1;
+    if (!ReadLine(line)) {
+      reading_ = false;
+      return;
+    }
+  }
+
+  // Whatever is left is an incomplete line, which may only end with a CR.
+  const char* const tail = buffer + read_start_;
+  if (end - tail > 1 && memchr(tail, 0x0d, end - 1 - tail)) {
+    VLOG(1) << "tor: stray carriage return";
+    Error();
+    return;
   }
 
   // If we've walked up to the end of the buffer, try shifting it to
@@ -708,7 +715,6 @@ void TorControl::ReadDone(int rv) {
     reading_ = false;
     readiobuf_.reset();
     read_start_ = 0;
-    read_cr_ = false;
     return;
   }
 }
@@ -718,7 +724,7 @@ void TorControl::ReadDone(int rv) {
 //      We have read a line of input; process it.  Return true on
 //      success, false on error.
 //
-bool TorControl::ReadLine(const std::string& line) {
+bool TorControl::ReadLine(base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
 
   if (line.size() < 4) {
@@ -733,9 +739,9 @@ bool TorControl::ReadLine(const std::string& line) {
   // intermediate reply and ` ' for a final reply.
   //
   // TODO(riastradh): parse or check syntax of status
-  std::string status(line, 0, 3);
-  char pos = line[3];
-  std::string reply(line, 4);
+  const base::StringPiece status = line.substr(0, 3);
+  const char pos = line[3];
+  const base::StringPiece reply = line.substr(4);
 
   // Determine whether it is an asynchronous reply, status 6yz.
   if (status[0] == '6') {
@@ -746,8 +752,8 @@ bool TorControl::ReadLine(const std::string& line) {
     if (!async_) {
       // Parse the keyword and the initial line.
       const size_t sp = reply.find(' ');
-      std::string event_name, initial;
-      if (sp == std::string::npos) {
+      base::StringPiece event_name, initial;
+      if (sp == base::StringPiece::npos) {
         event_name = reply;
       } else {
         event_name = reply.substr(0, sp);
@@ -760,7 +766,8 @@ bool TorControl::ReadLine(const std::string& line) {
           // Single-line async reply.
 
           // Bail if we don't recognize the event name.
-          const auto& found = kTorControlEventByName.find(event_name);
+          const auto& found =
+              kTorControlEventByName.find(std::string(event_name));
           if (found == kTorControlEventByName.end()) {
             VLOG(1) << "tor: unknown event: " << event_name;  // XXX escape
             return false;
@@ -784,13 +791,14 @@ bool TorControl::ReadLine(const std::string& line) {
 
           // Start a fresh async reply state.  Parse the rest, but
           // skip it, if we don't recognize the event.
-          const auto& found = kTorControlEventByName.find(event_name);
+          const auto& found =
+              kTorControlEventByName.find(std::string(event_name));
           const TorControlEvent event =
               (found == kTorControlEventByName.end() ? TorControlEvent::INVALID
                                                      : (*found).second);
           async_ = std::make_unique<Async>();
           async_->event = event;
-          async_->initial = initial;
+          async_->initial = std::string(initial);
           async_->skip = (event == TorControlEvent::INVALID);
           return true;
         }
@@ -813,7 +821,7 @@ bool TorControl::ReadLine(const std::string& line) {
             return true;
           }
           std::string key, value;
-          if (!ParseKV(reply, &key, &value)) {
+          if (!ParseKV(std::string(reply), &key, &value)) {
             VLOG(1) << "tor: invalid async continuation line";
             Error();
             return false;
@@ -831,7 +839,7 @@ bool TorControl::ReadLine(const std::string& line) {
           // we're skipping.
           if (!async_->skip) {
             std::string key, value;
-            if (!ParseKV(reply, &key, &value)) {
+            if (!ParseKV(std::string(reply), &key, &value)) {
               VLOG(1) << "tor: invalid async event";
               Error();
               return false;
@@ -846,7 +854,8 @@ bool TorControl::ReadLine(const std::string& line) {
             // If we're still subscribed, notify the delegate of the
             // parsed reply.
             if (async_events_.count(async_->event)) {
-              NotifyTorEvent(async_->event, async_->initial, async_->extra);
+              NotifyTorEvent(async_->event, async_->initial,
+                             std::move(async_->extra));
             }
           }
           async_.reset();
@@ -861,8 +870,10 @@ bool TorControl::ReadLine(const std::string& line) {
       case '-':
         NotifyTorRawMid(status, reply);
         if (!cmdq_.empty()) {
+          // Keep queued notifications ahead of the command's own replies.
+          FlushNotifications();
           PerLineCallback& perline = cmdq_.front().first;
-          perline.Run(status, reply);
+          perline.Run(std::string(status), std::string(reply));
         }
         return true;
       case '+':
@@ -872,9 +883,11 @@ bool TorControl::ReadLine(const std::string& line) {
       case ' ':
         NotifyTorRawEnd(status, reply);
         if (!cmdq_.empty()) {
+          FlushNotifications();
           CmdCallback& callback = cmdq_.front().second;
           bool error = false;
-          std::move(callback).Run(error, status, reply);
+          std::move(callback).Run(error, std::string(status),
+                                  std::string(reply));
           cmdq_.pop();
         }
         return true;
@@ -900,6 +913,7 @@ void TorControl::Error() {
 
   VLOG(1) << "tor: closing control on " << (running_ ? "request" : "error");
 
+  FlushNotifications();
   NotifyTorControlClosed();
 
   // Invoke all callbacks with errors and clear read state.
@@ -912,7 +926,6 @@ void TorControl::Error() {
   reading_ = false;
   readiobuf_.reset();
   read_start_ = -1;
-  read_cr_ = false;
 
   // Clear write state.
   writeq_ = {};
@@ -937,14 +950,16 @@ void TorControl::NotifyTorControlClosed() {
                                 delegate_->AsWeakPtr(), running_));
 }
 
-void TorControl::NotifyTorEvent(
-    TorControlEvent event,
-    const std::string& initial,
-    const std::map<std::string, std::string>& extra) {
+void TorControl::NotifyTorEvent(TorControlEvent event,
+                                base::StringPiece initial,
+                                std::map<std::string, std::string> extra) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  owner_task_runner_->PostTask(
-      FROM_HERE, base::BindOnce(&Delegate::OnTorEvent, delegate_->AsWeakPtr(),
-                                event, initial, extra));
+  Notification notification;
+  notification.type = Notification::Type::kEvent;
+  notification.event = event;
+  notification.first = std::string(initial);
+  notification.extra = std::move(extra);
+  QueueNotification(std::move(notification));
 }
 
 void TorControl::NotifyTorRawCmd(const std::string& cmd) {
@@ -954,28 +969,109 @@ void TorControl::NotifyTorRawCmd(const std::string& cmd) {
       base::BindOnce(&Delegate::OnTorRawCmd, delegate_->AsWeakPtr(), cmd));
 }
 
-void TorControl::NotifyTorRawAsync(const std::string& status,
-                                   const std::string& line) {
+void TorControl::NotifyTorRawAsync(base::StringPiece status,
+                                   base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  owner_task_runner_->PostTask(
-      FROM_HERE, base::BindOnce(&Delegate::OnTorRawAsync,
-                                delegate_->AsWeakPtr(), status, line));
+  Notification notification;
+  notification.type = Notification::Type::kRawAsync;
+  notification.first = std::string(status);
+  notification.second = std::string(line);
+  QueueNotification(std::move(notification));
 }
 
-void TorControl::NotifyTorRawMid(const std::string& status,
-                                 const std::string& line) {
+void TorControl::NotifyTorRawMid(base::StringPiece status,
+                                 base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  owner_task_runner_->PostTask(
-      FROM_HERE, base::BindOnce(&Delegate::OnTorRawMid, delegate_->AsWeakPtr(),
-                                status, line));
+  Notification notification;
+  notification.type = Notification::Type::kRawMid;
+  notification.first = std::string(status);
+  notification.second = std::string(line);
+  QueueNotification(std::move(notification));
 }
 
-void TorControl::NotifyTorRawEnd(const std::string& status,
-                                 const std::string& line) {
+void TorControl::NotifyTorRawEnd(base::StringPiece status,
+                                 base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  Notification notification;
+  notification.type = Notification::Type::kRawEnd;
+  notification.first = std::string(status);
+  notification.second = std::string(line);
+  QueueNotification(std::move(notification));
+}
+
+TorControl::Notification::Notification() = default;
+TorControl::Notification::Notification(Notification&&) = default;
+TorControl::Notification& TorControl::Notification::operator=(
+    Notification&&) = default;
+TorControl::Notification::~Notification() = default;
+
+// QueueNotification(notification)
+//
+//      Queue a notification for the delegate until the end of the
+//      current read.  Bandwidth events only matter as the latest
+//      value, so a newer one drops one already queued.  It is queued
+//      at the tail so that it is still delivered after everything
+//      that arrived before it.
+//
+void TorControl::QueueNotification(Notification notification) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  if (notification.type == Notification::Type::kEvent &&
+      notification.event == TorControlEvent::BW) {
+    const auto it = coalesced_notifications_.find(notification.event);
+    if (it != coalesced_notifications_.end()) {
+      const size_t stale = it->second;
+      pending_notifications_.erase(pending_notifications_.begin() + stale);
+      for (auto& coalesced : coalesced_notifications_) {
+        if (coalesced.second > stale)
+          coalesced.second--;
+      }
+    }
+    coalesced_notifications_[notification.event] =
+        pending_notifications_.size();
+  }
+  pending_notifications_.push_back(std::move(notification));
+}
+
+// FlushNotifications()
+//
+//      Post all queued notifications to the delegate as a single task.
+//
+void TorControl::FlushNotifications() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  if (pending_notifications_.empty())
+    return;
+  coalesced_notifications_.clear();
   owner_task_runner_->PostTask(
-      FROM_HERE, base::BindOnce(&Delegate::OnTorRawEnd, delegate_->AsWeakPtr(),
-                                status, line));
+      FROM_HERE,
+      base::BindOnce(&TorControl::DispatchNotifications,
+                     delegate_->AsWeakPtr(),
+                     std::exchange(pending_notifications_, {})));
+}
+
+// static
+void TorControl::DispatchNotifications(
+    base::WeakPtr<Delegate> delegate,
+    std::vector<Notification> notifications) {
+  for (const auto& notification : notifications) {
+    // The delegate may go away while handling any of these.
+    if (!delegate)
+      return;
+    switch (notification.type) {
+      case Notification::Type::kEvent:
+        delegate->OnTorEvent(notification.event, notification.first,
+                             notification.extra);
+        break;
+      case Notification::Type::kRawAsync:
+        delegate->OnTorRawAsync(notification.first, notification.second);
+        break;
+      case Notification::Type::kRawMid:
+        delegate->OnTorRawMid(notification.first, notification.second);
+        break;
+      case Notification::Type::kRawEnd:
+        delegate->OnTorRawEnd(notification.first, notification.second);
+        break;
+    }
+  }
 }
 
 // ParseKV(string, key, value)
@@ -18,6 +18,7 @@
 #include "base/callback.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/strings/string_piece.h"
 
 namespace base {
 class SequencedTaskRunner;
@@ -96,6 +97,7 @@ class TorControl {
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, ParseQuoted);
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, ParseKV);
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, ReadLine);
+  FRIEND_TEST_ALL_PREFIXES(TorControlTest, ReadDone);
 
   static bool ParseKV(const std::string& string,
                       std::string* key,
@@ -158,13 +160,13 @@ class TorControl {
   void NotifyTorControlReady();
   void NotifyTorControlClosed();
 
-  void NotifyTorEvent(TorControlEvent,
-                      const std::string& initial,
-                      const std::map<std::string, std::string>& extra);
+  void NotifyTorEvent(TorControlEvent event,
+                      base::StringPiece initial,
+                      std::map<std::string, std::string> extra);
   void NotifyTorRawCmd(const std::string& cmd);
-  void NotifyTorRawAsync(const std::string& status, const std::string& line);
-  void NotifyTorRawMid(const std::string& status, const std::string& line);
-  void NotifyTorRawEnd(const std::string& status, const std::string& line);
+  void NotifyTorRawAsync(base::StringPiece status, base::StringPiece line);
+  void NotifyTorRawMid(base::StringPiece status, base::StringPiece line);
+  void NotifyTorRawEnd(base::StringPiece status, base::StringPiece line);
 
   void StartWrite();
   void DoWrites();
@@ -175,10 +177,34 @@ class TorControl {
   void DoReads();
   void ReadDoneAsync(int rv);
   void ReadDone(int rv);
-  bool ReadLine(const std::string& line);
+  bool ReadLine(base::StringPiece line);
 
   void Error();
 
+  // Events and raw lines parsed on the IO sequence are queued and handed to
+  // the delegate in a single task per read instead of one task per line.
+  struct Notification {
+    enum class Type { kEvent, kRawAsync, kRawMid, kRawEnd };
+
+    Notification();
+    Notification(Notification&&);
+    Notification& operator=(Notification&&);
+    ~Notification();
+
+    Type type = Type::kEvent;
+    TorControlEvent event = TorControlEvent::INVALID;
+    // Event initial line or raw status.
+    std::string first;
+    // Raw line.
+    std::string second;
+    std::map<std::string, std::string> extra;
+  };
+
+  void QueueNotification(Notification notification);
+  void FlushNotifications();
+  static void DispatchNotifications(base::WeakPtr<Delegate> delegate,
+                                    std::vector<Notification> notifications);
+
   TorControl(const TorControl&) = delete;
   TorControl& operator=(const TorControl&) = delete;
 
@@ -201,7 +227,11 @@ class TorControl {
   bool reading_;
   scoped_refptr<net::GrowableIOBuffer> readiobuf_;
   int read_start_;  // offset where the current line starts
-  bool read_cr_;    // true if we have parsed a CR
+
+  std::vector<Notification> pending_notifications_;
+  // Index in |pending_notifications_| of the queued event for each coalesced
+  // event type.
+  std::map<TorControlEvent, size_t> coalesced_notifications_;
 
   // Asynchronous command response callback state machine.
   std::map<TorControlEvent, size_t> async_events_;
@@ -5,11 +5,14 @@
 
 #include "brave/components/tor/tor_control.h"
 
+#include <string.h>
+
 #include "base/callback_helpers.h"
 #include "base/run_loop.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/test/browser_task_environment.h"
+#include "net/base/io_buffer.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -131,6 +134,7 @@ TEST(TorControlTest, ReadLine) {
                      [](std::unique_ptr<TorControl> control) {
                        EXPECT_TRUE(control->ReadLine("250-SOCKSPORT=9050"));
                        EXPECT_TRUE(control->ReadLine("250 OK"));
+                       control->FlushNotifications();
                      },
                      std::move(control)));
 
@@ -178,10 +182,104 @@ TEST(TorControlTest, ReadLine) {
             EXPECT_TRUE(control->ReadLine("650-EXTRAMAGIC=99"));
             EXPECT_TRUE(control->ReadLine("650 ANONYMITY=high"));
             EXPECT_FALSE(control->async_);
+            control->FlushNotifications();
           },
           std::move(control)));
 
   base::RunLoop().RunUntilIdle();
 }
 
+TEST(TorControlTest, ReadDone) {
+  // Recorded control port output with CIRC, STREAM and BW subscribed.
+  const char kTranscript[] =
+      "250-version=0.4.4.6\r\n"
+      "250 OK\r\n"
+      "650 BW 1024 2048\r\n"
+      "650 CIRC 1 LAUNCHED BUILD_FLAGS=NEED_CAPACITY PURPOSE=GENERAL\r\n"
+      "650 BW 0 512\r\n"
+      "650 STREAM 7 NEW 0 example.com:443 SOURCE_ADDR=127.0.0.1:50000 "
+      "PURPOSE=USER\r\n"
+      "650-CIRC 1 EXTENDED\r\n"
+      "650 ANONYMITY=high\r\n"
+      "650 BW 4096 8192\r\n";
+
+  content::BrowserTaskEnvironment task_environment;
+  scoped_refptr<base::SequencedTaskRunner> io_task_runner =
+      content::GetIOThreadTaskRunner({});
+
+  MockTorControlDelegate delegate;
+  std::unique_ptr<TorControl> control =
+      std::make_unique<TorControl>(&delegate, io_task_runner);
+
+  using tor::TorControlEvent;
+  // Bandwidth events queued during the same read are coalesced into the
+  // latest one, which keeps its place after the events that preceded it.
+  EXPECT_CALL(delegate, OnTorEvent(TorControlEvent::BW, "0 512", testing::_))
+      .Times(0);
+
+  testing::InSequence in_sequence;
+  // First read.
+  EXPECT_CALL(delegate, OnTorRawMid("250", "version=0.4.4.6")).Times(1);
+  EXPECT_CALL(delegate, OnTorRawEnd("250", "OK")).Times(1);
+  EXPECT_CALL(delegate, OnTorRawAsync("650", "BW 1024 2048")).Times(1);
+  EXPECT_CALL(delegate,
+              OnTorEvent(TorControlEvent::BW, "1024 2048", testing::_))
+      .Times(1);
+  // Second read.
+  EXPECT_CALL(delegate,
+              OnTorRawAsync("650",
+                            "CIRC 1 LAUNCHED BUILD_FLAGS=NEED_CAPACITY "
+                            "PURPOSE=GENERAL"))
+      .Times(1);
+  EXPECT_CALL(delegate, OnTorEvent(TorControlEvent::CIRC,
+                                   "1 LAUNCHED BUILD_FLAGS=NEED_CAPACITY "
+                                   "PURPOSE=GENERAL",
+                                   testing::_))
+      .Times(1);
+  EXPECT_CALL(delegate, OnTorRawAsync("650", "BW 0 512")).Times(1);
+  EXPECT_CALL(delegate, OnTorRawAsync("650", testing::StartsWith("STREAM 7")))
+      .Times(1);
+  EXPECT_CALL(delegate,
+              OnTorEvent(TorControlEvent::STREAM, testing::_, testing::_))
+      .Times(1);
+  EXPECT_CALL(delegate, OnTorRawAsync("650", "CIRC 1 EXTENDED")).Times(1);
+  EXPECT_CALL(delegate, OnTorRawAsync("650", "ANONYMITY=high")).Times(1);
+  std::map<std::string, std::string> circ_extra = {{"ANONYMITY", "high"}};
+  EXPECT_CALL(delegate,
+              OnTorEvent(TorControlEvent::CIRC, "1 EXTENDED", circ_extra))
+      .Times(1);
+  EXPECT_CALL(delegate, OnTorRawAsync("650", "BW 4096 8192")).Times(1);
+  EXPECT_CALL(delegate,
+              OnTorEvent(TorControlEvent::BW, "4096 8192", testing::_))
+      .Times(1);
+
+  io_task_runner->PostTask(
+      FROM_HERE,
+      base::BindOnce(
+          [](std::unique_ptr<TorControl> control, std::string transcript) {
+            control->async_events_[TorControlEvent::BW] = 1;
+            control->async_events_[TorControlEvent::CIRC] = 1;
+            control->async_events_[TorControlEvent::STREAM] = 1;
+            control->reading_ = true;
+            control->readiobuf_ = base::MakeRefCounted<net::GrowableIOBuffer>();
+            control->readiobuf_->SetCapacity(4096);
+            control->read_start_ = 0;
+
+            // Deliver the transcript in two reads split between a CR and
+            // its LF.
+            const size_t split = transcript.find("\r\n650 BW 0") + 1;
+            memcpy(control->readiobuf_->data(), transcript.data(), split);
+            control->ReadDone(split);
+            ASSERT_TRUE(control->reading_);
+            memcpy(control->readiobuf_->data(), transcript.data() + split,
+                   transcript.size() - split);
+            control->ReadDone(transcript.size() - split);
+            EXPECT_TRUE(control->reading_);
+            EXPECT_EQ(control->read_start_, control->readiobuf_->offset());
+          },
+          std::move(control), std::string(kTranscript)));
+
+  base::RunLoop().RunUntilIdle();
+}
+
 }  // namespace tor
@@ -5,7 +5,7 @@
 
 #include "brave/components/weekly_storage/weekly_storage.h"
 
-#include <numeric>
+#include <algorithm>
 #include <utility>
 
 #include "base/time/clock.h"
@@ -14,9 +14,8 @@
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
 
-namespace {
-constexpr size_t kDaysInWeek = 7;
-}
+// static
+constexpr size_t WeeklyStorage::kDaysInWeek;
 
 WeeklyStorage::WeeklyStorage(PrefService* prefs, const char* pref_name)
     : prefs_(prefs),
@@ -41,83 +40,106 @@ WeeklyStorage::~WeeklyStorage() = default;
 
 void WeeklyStorage::AddDelta(uint64_t delta) {
   FilterToWeek();
-  daily_values_.front().value += delta;
-  Save();
+  DayAt(0).value += delta;
+  OnChanged();
 }
 
 void WeeklyStorage::ReplaceTodaysValueIfGreater(uint64_t value) {
   FilterToWeek();
-  DailyValue& today = daily_values_.front();
+  DailyValue& today = DayAt(0);
   if (today.value < value) {
     today.value = value;
   }
-  Save();
+  OnChanged();
 }
 
 uint64_t WeeklyStorage::GetWeeklySum() const {
   // We record only value for last N days.
   const base::Time n_days_ago =
       clock_->Now() - base::TimeDelta::FromDays(kDaysInWeek);
-  return std::accumulate(daily_values_.begin(), daily_values_.end(), 0ull,
-                         [n_days_ago](const uint64_t acc, const auto& u2) {
-                           uint64_t add = 0;
-                           // Check only last continious days.
-                           if (u2.day > n_days_ago) {
-                             add = u2.value;
-                           }
-                           return acc + add;
-                         });
+  uint64_t sum = 0;
+  for (size_t i = 0; i < day_count_; ++i) {
+    // Check only last continious days.
+    if (DayAt(i).day > n_days_ago) {
+      sum += DayAt(i).value;
+    }
+  }
+  return sum;
 }
 
 uint64_t WeeklyStorage::GetHighestValueInWeek() const {
   // We record only value for last N days.
   const base::Time n_days_ago =
       clock_->Now() - base::TimeDelta::FromDays(kDaysInWeek);
-  std::list<DailyValue> last_weeks_daily_values(daily_values_.size());
-  auto copied_it =
-      std::copy_if(daily_values_.begin(), daily_values_.end(),
-                   last_weeks_daily_values.begin(),
-                   [n_days_ago](auto i) { return i.day > n_days_ago; });
-  last_weeks_daily_values.resize(
-      std::distance(last_weeks_daily_values.begin(), copied_it));
-
-  auto highest_it = std::max_element(last_weeks_daily_values.begin(),
-                                     last_weeks_daily_values.end(),
-                                     [](const auto& left, const auto& right) {
-                                       return left.value < right.value;
-                                     });
-  if (highest_it == last_weeks_daily_values.end()) {
-    return 0;
+  uint64_t highest = 0;
+  for (size_t i = 0; i < day_count_; ++i) {
+    if (DayAt(i).day > n_days_ago) {
+      highest = std::max(highest, DayAt(i).value);
+    }
   }
-  return highest_it->value;
+  return highest;
 }
 
 bool WeeklyStorage::IsOneWeekPassed() const {
   // TODO(iefremov): This is not true 100% (if the browser was launched once
   // per week just after installation, for example).
-  return daily_values_.size() == kDaysInWeek;
+  return day_count_ == kDaysInWeek;
+}
+
+void WeeklyStorage::SetDeferredSave(base::RepeatingClosure on_changed) {
+  on_changed_ = std::move(on_changed);
+}
+
+void WeeklyStorage::Flush() {
+  if (!dirty_) {
+    return;
+  }
+  dirty_ = false;
+  Save();
+}
+
+WeeklyStorage::DailyValue& WeeklyStorage::DayAt(size_t index) {
+  DCHECK_LT(index, day_count_);
+  return daily_values_[(first_day_ + index) % kDaysInWeek];
+}
+
+const WeeklyStorage::DailyValue& WeeklyStorage::DayAt(size_t index) const {
+  DCHECK_LT(index, day_count_);
+  return daily_values_[(first_day_ + index) % kDaysInWeek];
 }
 
 void WeeklyStorage::FilterToWeek() {
   base::Time now_midnight = clock_->Now().LocalMidnight();
   base::Time last_saved_midnight;
 
-  if (!daily_values_.empty()) {
-    last_saved_midnight = daily_values_.front().day;
+  if (day_count_ > 0) {
+    last_saved_midnight = DayAt(0).day;
   }
 
+  // A clock that went backwards keeps adding to the most recent day.
   if (now_midnight - last_saved_midnight > base::TimeDelta()) {
     // Day changed. Since we consider only small incoming intervals, lets just
-    // save it with a new timestamp.
-    daily_values_.push_front({now_midnight, 0});
-    if (daily_values_.size() > kDaysInWeek) {
-      daily_values_.pop_back();
+    // save it with a new timestamp. Once the buffer is full the new day takes
+    // the slot of the oldest one.
+    first_day_ = (first_day_ + kDaysInWeek - 1) % kDaysInWeek;
+    daily_values_[first_day_] = {now_midnight, 0};
+    if (day_count_ < kDaysInWeek) {
+      ++day_count_;
     }
   }
 }
 
+void WeeklyStorage::OnChanged() {
+  if (!on_changed_) {
+    Save();
+    return;
+  }
+  dirty_ = true;
+  on_changed_.Run();
+}
+
 void WeeklyStorage::Load() {
-  DCHECK(daily_values_.empty());
+  DCHECK_EQ(day_count_, 0u);
   const base::ListValue* list = prefs_->GetList(pref_name_);
   if (!list) {
     return;
@@ -128,23 +150,22 @@ void WeeklyStorage::Load() {
     if (!day || !value || !day->is_double() || !value->is_double()) {
       continue;
     }
-    if (daily_values_.size() == kDaysInWeek) {
+    if (day_count_ == kDaysInWeek) {
       break;
     }
-    daily_values_.push_back({base::Time::FromDoubleT(day->GetDouble()),
-                             static_cast<uint64_t>(value->GetDouble())});
+    daily_values_[day_count_++] = {base::Time::FromDoubleT(day->GetDouble()),
+                                   static_cast<uint64_t>(value->GetDouble())};
   }
 }
 
 void WeeklyStorage::Save() {
-  DCHECK(!daily_values_.empty());
-  DCHECK_LE(daily_values_.size(), kDaysInWeek);
+  DCHECK_GT(day_count_, 0u);
 
   ListPrefUpdate update(prefs_, pref_name_);
   base::ListValue* list = update.Get();
-  // TODO(iefremov): Optimize if needed.
   list->Clear();
-  for (const auto& u : daily_values_) {
+  for (size_t i = 0; i < day_count_; ++i) {
+    const DailyValue& u = DayAt(i);
     base::DictionaryValue value;
     value.SetKey("day", base::Value(u.day.ToDoubleT()));
     value.SetDoubleKey("value", u.value);
@@ -6,9 +6,10 @@
 #ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 #define BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 
-#include <list>
+#include <array>
 #include <memory>
 
+#include "base/callback.h"
 #include "base/time/time.h"
 
 namespace base {
@@ -41,12 +42,24 @@ class WeeklyStorage {
   uint64_t GetHighestValueInWeek() const;
   bool IsOneWeekPassed() const;
 
+  // Stops writing the pref on every change. |on_changed| runs after each
+  // change instead, and the owner is expected to call |Flush| later.
+  void SetDeferredSave(base::RepeatingClosure on_changed);
+  // Writes pending changes to the pref, if any.
+  void Flush();
+
  private:
+  static constexpr size_t kDaysInWeek = 7;
+
   struct DailyValue {
     base::Time day;
     uint64_t value = 0ull;
   };
+  // |index| 0 is the most recent day.
+  DailyValue& DayAt(size_t index);
+  const DailyValue& DayAt(size_t index) const;
   void FilterToWeek();
+  void OnChanged();
   void Load();
   void Save();
 
@@ -54,7 +67,13 @@ class WeeklyStorage {
   const char* pref_name_ = nullptr;
   std::unique_ptr<base::Clock> clock_;
 
-  std::list<DailyValue> daily_values_;
+  // Ring buffer of the last days with recorded values, most recent first.
+  std::array<DailyValue, kDaysInWeek> daily_values_;
+  size_t first_day_ = 0;
+  size_t day_count_ = 0;
+
+  base::RepeatingClosure on_changed_;
+  bool dirty_ = false;
 };
 
 #endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
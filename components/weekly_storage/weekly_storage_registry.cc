@@ -0,0 +1,63 @@
+/* Copyright 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "brave/components/weekly_storage/weekly_storage.h"
+#include "components/prefs/pref_service.h"
+
+namespace {
+
+constexpr base::TimeDelta kFlushDelay = base::TimeDelta::FromSeconds(30);
+
+}  // namespace
+
+WeeklyStorageRegistry::WeeklyStorageRegistry(PrefService* prefs)
+    : prefs_(prefs) {
+  DCHECK(prefs);
+}
+
+WeeklyStorageRegistry::~WeeklyStorageRegistry() {
+  Flush();
+}
+
+WeeklyStorage* WeeklyStorageRegistry::Get(const std::string& pref_name) {
+  auto it = storages_.find(pref_name);
+  if (it != storages_.end()) {
+    return it->second.get();
+  }
+  if (!prefs_->FindPreference(pref_name)) {
+    return nullptr;
+  }
+
+  it = storages_.emplace(pref_name, nullptr).first;
+  it->second = std::make_unique<WeeklyStorage>(prefs_, it->first.c_str());
+  it->second->SetDeferredSave(base::BindRepeating(
+      &WeeklyStorageRegistry::OnStorageChanged, base::Unretained(this)));
+  return it->second.get();
+}
+
+void WeeklyStorageRegistry::Flush() {
+  flush_timer_.Stop();
+  for (auto& storage : storages_) {
+    storage.second->Flush();
+  }
+}
+
+void WeeklyStorageRegistry::Shutdown() {
+  Flush();
+}
+
+void WeeklyStorageRegistry::OnStorageChanged() {
+  if (flush_timer_.IsRunning()) {
+    return;
+  }
+  flush_timer_.Start(FROM_HERE, kFlushDelay,
+                     base::BindOnce(&WeeklyStorageRegistry::Flush,
+                                    base::Unretained(this)));
+}
@@ -0,0 +1,49 @@
+/* Copyright 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_H_
+#define BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_H_
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/timer/timer.h"
+#include "components/keyed_service/core/keyed_service.h"
+
+class PrefService;
+class WeeklyStorage;
+
+// Keeps one live |WeeklyStorage| per pref of a |PrefService|, so recorders
+// that fire often neither reload the list pref nor rewrite it on every
+// event. Changes are written back shortly after they happen and on shutdown.
+class WeeklyStorageRegistry : public KeyedService {
+ public:
+  explicit WeeklyStorageRegistry(PrefService* prefs);
+  ~WeeklyStorageRegistry() override;
+
+  WeeklyStorageRegistry(const WeeklyStorageRegistry&) = delete;
+  WeeklyStorageRegistry& operator=(const WeeklyStorageRegistry&) = delete;
+
+  // Returns the storage backed by |pref_name|, or nullptr if that pref is
+  // not registered.
+  WeeklyStorage* Get(const std::string& pref_name);
+
+  // Writes all pending changes to prefs.
+  void Flush();
+
+  // KeyedService:
+  void Shutdown() override;
+
+ private:
+  void OnStorageChanged();
+
+  PrefService* prefs_ = nullptr;
+  // Keyed by pref name; the storages keep pointers to the key strings.
+  std::map<std::string, std::unique_ptr<WeeklyStorage>> storages_;
+  base::OneShotTimer flush_timer_;
+};
+
+#endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_H_
@@ -0,0 +1,85 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
+
+#include <memory>
+
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "brave/components/weekly_storage/weekly_storage.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+constexpr char kPrefName[] = "brave.weekly_test";
+constexpr char kOtherPrefName[] = "brave.weekly_test_other";
+}  // namespace
+
+class WeeklyStorageRegistryTest : public ::testing::Test {
+ public:
+  WeeklyStorageRegistryTest() {
+    pref_service_.registry()->RegisterListPref(kPrefName);
+    pref_service_.registry()->RegisterListPref(kOtherPrefName);
+    registry_ = std::make_unique<WeeklyStorageRegistry>(&pref_service_);
+  }
+
+ protected:
+  size_t SavedDays(const char* pref_name) {
+    return pref_service_.GetList(pref_name)->GetList().size();
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  TestingPrefServiceSimple pref_service_;
+  std::unique_ptr<WeeklyStorageRegistry> registry_;
+};
+
+TEST_F(WeeklyStorageRegistryTest, ReturnsSameStorage) {
+  WeeklyStorage* storage = registry_->Get(kPrefName);
+  ASSERT_TRUE(storage);
+  EXPECT_EQ(storage, registry_->Get(kPrefName));
+  EXPECT_NE(storage, registry_->Get(kOtherPrefName));
+}
+
+TEST_F(WeeklyStorageRegistryTest, UnregisteredPref) {
+  EXPECT_FALSE(registry_->Get("brave.weekly_test_unregistered"));
+}
+
+TEST_F(WeeklyStorageRegistryTest, DefersSave) {
+  WeeklyStorage* storage = registry_->Get(kPrefName);
+  storage->AddDelta(10);
+  storage->AddDelta(20);
+  EXPECT_EQ(storage->GetWeeklySum(), 30ULL);
+  EXPECT_EQ(SavedDays(kPrefName), 0u);
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  EXPECT_EQ(SavedDays(kPrefName), 1u);
+
+  // A fresh storage reads back what was flushed.
+  WeeklyStorage reloaded(&pref_service_, kPrefName);
+  EXPECT_EQ(reloaded.GetWeeklySum(), 30ULL);
+}
+
+TEST_F(WeeklyStorageRegistryTest, FlushesOnShutdown) {
+  registry_->Get(kPrefName)->AddDelta(10);
+  registry_->Get(kOtherPrefName)->ReplaceTodaysValueIfGreater(5);
+  EXPECT_EQ(SavedDays(kPrefName), 0u);
+  EXPECT_EQ(SavedDays(kOtherPrefName), 0u);
+
+  registry_->Shutdown();
+  EXPECT_EQ(SavedDays(kPrefName), 1u);
+  EXPECT_EQ(SavedDays(kOtherPrefName), 1u);
+}
+
+TEST_F(WeeklyStorageRegistryTest, LoadsExistingValues) {
+  {
+    WeeklyStorage storage(&pref_service_, kPrefName);
+    storage.AddDelta(42);
+  }
+  EXPECT_EQ(registry_->Get(kPrefName)->GetWeeklySum(), 42ULL);
+}
@@ -8,16 +8,20 @@
 #include <memory>
 #include <utility>
 
+#include "base/test/bind.h"
 #include "base/test/simple_test_clock.h"
 #include "base/time/time.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+namespace {
+constexpr char kPrefName[] = "brave.weekly_test";
+}  // namespace
+
 class WeeklyStorageTest : public ::testing::Test {
  public:
   WeeklyStorageTest() : clock_(new base::SimpleTestClock) {
-    constexpr char kPrefName[] = "brave.weekly_test";
     pref_service_.registry()->RegisterListPref(kPrefName);
 
     state_ = std::make_unique<WeeklyStorage>(
@@ -26,6 +30,13 @@ class WeeklyStorageTest : public ::testing::Test {
   }
 
  protected:
+  std::unique_ptr<WeeklyStorage> Reload() {
+    auto* clock = new base::SimpleTestClock;
+    clock->SetNow(clock_->Now());
+    return std::make_unique<WeeklyStorage>(
+        &pref_service_, kPrefName, std::unique_ptr<base::Clock>(clock));
+  }
+
   base::SimpleTestClock* clock_;
   TestingPrefServiceSimple pref_service_;
   std::unique_ptr<WeeklyStorage> state_;
@@ -138,3 +149,50 @@ TEST_F(WeeklyStorageTest, GetsHighestValueInWeekFromReplacement) {
   // Sanity check disparate days were not replaced
   EXPECT_EQ(state_->GetWeeklySum(), high_value + low_value);
 }
+
+TEST_F(WeeklyStorageTest, DayRolloverKeepsLastWeek) {
+  // Wrap the ring buffer around a couple of times.
+  for (int day = 1; day <= 20; day++) {
+    clock_->Advance(base::TimeDelta::FromDays(1));
+    state_->AddDelta(day);
+  }
+  EXPECT_TRUE(state_->IsOneWeekPassed());
+  // Days 14..20.
+  EXPECT_EQ(state_->GetWeeklySum(), 119ULL);
+  EXPECT_EQ(state_->GetHighestValueInWeek(), 20ULL);
+
+  auto reloaded = Reload();
+  EXPECT_EQ(reloaded->GetWeeklySum(), 119ULL);
+  EXPECT_EQ(reloaded->GetHighestValueInWeek(), 20ULL);
+}
+
+TEST_F(WeeklyStorageTest, ClockGoingBackwards) {
+  uint64_t saving = 10000;
+  state_->AddDelta(saving);
+  clock_->Advance(base::TimeDelta::FromDays(1));
+  state_->AddDelta(saving);
+
+  // Values recorded while the clock is behind go to the most recent day
+  // instead of starting a new one.
+  clock_->Advance(-base::TimeDelta::FromDays(3));
+  state_->AddDelta(saving);
+  EXPECT_FALSE(state_->IsOneWeekPassed());
+
+  clock_->Advance(base::TimeDelta::FromDays(3));
+  EXPECT_EQ(state_->GetWeeklySum(), 3 * saving);
+  EXPECT_EQ(state_->GetHighestValueInWeek(), 2 * saving);
+  EXPECT_EQ(Reload()->GetWeeklySum(), 3 * saving);
+}
+
+TEST_F(WeeklyStorageTest, DeferredSave) {
+  int changes = 0;
+  state_->SetDeferredSave(
+      base::BindLambdaForTesting([&changes]() { changes++; }));
+  state_->AddDelta(10);
+  state_->ReplaceTodaysValueIfGreater(20);
+  EXPECT_EQ(changes, 2);
+  EXPECT_EQ(Reload()->GetWeeklySum(), 0ULL);
+
+  state_->Flush();
+  EXPECT_EQ(Reload()->GetWeeklySum(), 20ULL);
+}